@@ -0,0 +1,79 @@
+// **********************************************************************************************************
+// File name         : alarm.h                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Threshold and rate-of-change alarms on the samples, with hysteresis                  *
+// **********************************************************************************************************
+# ifndef _ALARM_H_
+# define _ALARM_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the threshold alarms out of the build
+#ifndef ALARM_ENABLED
+#define ALARM_ENABLED                           (1u)
+#endif
+
+// Alarm flags
+#define ALARM_TEMPERATURE_HIGH                  (1u << 0)
+#define ALARM_TEMPERATURE_LOW                   (1u << 1)
+#define ALARM_TEMPERATURE_RATE                  (1u << 2)
+#define ALARM_HUMIDITY_HIGH                     (1u << 3)
+#define ALARM_HUMIDITY_LOW                      (1u << 4)
+#define ALARM_HUMIDITY_RATE                     (1u << 5)
+
+// Threshold values which disable a level alarm (the thresholds are stored as 16 bits two's complement)
+#define ALARM_LEVEL_HIGH_OFF                    (0x7FFFu)
+#define ALARM_LEVEL_LOW_OFF                     (0x8000u)
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if ALARM_ENABLED
+// **********************************************************************************************************
+// Function name    : alarm_init                                                                            *
+// Description      : Load the thresholds from the parameters, called again when a parameter changes.       *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void alarm_init(void);
+
+// **********************************************************************************************************
+// Function name    : alarm_check                                                                           *
+// Description      : Check a sample against the thresholds.                                                *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+// Return value     : (uint8_t) : Alarm flags which changed with this sample (raised or cleared)            *
+// **********************************************************************************************************
+uint8_t alarm_check(int16_t i_temperature, uint16_t i_humidity);
+
+// **********************************************************************************************************
+// Function name    : alarm_missed                                                                          *
+// Description      : Signal a cycle without sample, the next rate is not computed across the gap.          *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void alarm_missed(void);
+
+// **********************************************************************************************************
+// Function name    : alarm_get_active                                                                      *
+// Description      : Get the active alarms.                                                                *
+// Argument         : None                                                                                  *
+// Return value     : (uint8_t) : Active alarm flags                                                        *
+// **********************************************************************************************************
+uint8_t alarm_get_active(void);
+#else
+// Left out of the build
+#define alarm_init()                            ((void) 0)
+#define alarm_check(temperature, humidity)      (0u)
+#define alarm_missed()                          ((void) 0)
+#define alarm_get_active()                      (0u)
+#endif
+
+# endif // _ALARM_H_
@@ -0,0 +1,106 @@
+// **********************************************************************************************************
+// File name         : clock.h                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Monotonic device clock, synchronized to the station clock with drift correction      *
+// **********************************************************************************************************
+# ifndef _CLOCK_H_
+# define _CLOCK_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 1 to add the synchronization with the station to the build, the timestamps run on the local clock
+// otherwise
+#ifndef CLOCK_SYNC_ENABLED
+#define CLOCK_SYNC_ENABLED                      (0u)
+#endif
+
+// Shortest interval between two synchronizations to measure the drift: 1 ms of reception jitter gives
+// less than 17 ppm
+#define CLOCK_DRIFT_INTERVAL_US                 (60000000u)
+
+// Largest drift accepted (the HSI is trimmed within 1 %), and averaging of the drift measurements (2^n)
+#define CLOCK_DRIFT_MAX_PPM                     (20000)
+#define CLOCK_DRIFT_SHIFT                       (2u)
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : clock_get_local_us                                                                    *
+// Description      : Get the local clock: wakeup timer periods and count since the timer start. The timer  *
+//                    keeps counting while the core sleeps. Can be called from an interrupt.                *
+// Argument         : None                                                                                  *
+// Return value     : (uint64_t) : Local time in microseconds                                               *
+// **********************************************************************************************************
+uint64_t clock_get_local_us(void);
+
+// **********************************************************************************************************
+// Function name    : clock_get_ms                                                                          *
+// Description      : Get the timestamp of the records: the station time once synchronized, the local time  *
+//                    before. It never goes back: a backward correction holds it until the time catches up. *
+// Argument         : None                                                                                  *
+// Return value     : (uint32_t) : Timestamp in milliseconds                                                *
+// **********************************************************************************************************
+uint32_t clock_get_ms(void);
+
+#if CLOCK_SYNC_ENABLED
+// **********************************************************************************************************
+// Function name    : clock_sync                                                                            *
+// Description      : Align the clock to the station time and measure the drift from the previous           *
+//                    synchronizations.                                                                     *
+// Argument         : (uint32_t) i_station_ms: Station time at the end of the synchronization command       *
+//                  : (uint64_t) i_local_us: Local time at the reception of the command                     *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void clock_sync(uint32_t i_station_ms, uint64_t i_local_us);
+
+// **********************************************************************************************************
+// Function name    : clock_is_synced                                                                       *
+// Description      : Tell whether the clock runs on the station time.                                      *
+// Argument         : None                                                                                  *
+// Return value     : (bool_e) : TRUE after the first synchronization                                       *
+// **********************************************************************************************************
+bool_e clock_is_synced(void);
+
+// **********************************************************************************************************
+// Function name    : clock_to_local_us                                                                     *
+// Description      : Convert a station time interval to the local clock, with the drift correction.        *
+// Argument         : (uint32_t) i_station_ms: Interval in station milliseconds                             *
+// Return value     : (uint32_t) : Interval in local microseconds                                           *
+// **********************************************************************************************************
+uint32_t clock_to_local_us(uint32_t i_station_ms);
+
+// **********************************************************************************************************
+// Function name    : clock_report                                                                          *
+// Description      : Send the last synchronization in a time frame: station time, error corrected and      *
+//                    drift.                                                                                *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void clock_report(void);
+#else
+// Left out of the build
+#define clock_sync(station_ms, local_us)        ((void) 0)
+#define clock_is_synced()                       (FALSE)
+#define clock_to_local_us(station_ms)           (0u)
+#define clock_report()                          ((void) 0)
+#endif
+
+// **********************************************************************************************************
+// Function name    : clock_divide                                                                          *
+// Description      : Divide a 64-bit value by a 32-bit one, one bit per step: a few microseconds, without  *
+//                    the 64-bit division of the C library (more than 600 bytes of flash).                  *
+// Argument         : (uint64_t) i_dividend: Dividend                                                       *
+//                  : (uint32_t) i_divisor: Divisor, not 0                                                  *
+// Return value     : (uint64_t) : Quotient, rounded down                                                   *
+// **********************************************************************************************************
+uint64_t clock_divide(uint64_t i_dividend, uint32_t i_divisor);
+
+# endif // _CLOCK_H_
@@ -0,0 +1,182 @@
+// **********************************************************************************************************
+// File name         : com.h                                                                                *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Framed communication with the station over the communication UART                    *
+// **********************************************************************************************************
+# ifndef _COM_H_
+# define _COM_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Frame layout: start of frame, type, payload size, payload, CRC8 over type, size and payload
+#define COM_FRAME_SOF                           (0xA5u)
+#define COM_FRAME_OVERHEAD                      (4u)
+
+// Bits per byte on the line (start, 8 data, stop)
+#define COM_BITS_PER_BYTE                       (10u)
+
+// Maximum payload size of a command received from the station
+#define COM_COMMAND_PAYLOAD_SIZE                (8u)
+
+// Set to 1 to add the baudrate negotiation and the automatic detection to the build, the node stays at the
+// configured baudrate otherwise
+#ifndef COM_BAUDRATE_ENABLED
+#define COM_BAUDRATE_ENABLED                    (0u)
+#endif
+
+// Cycles a new baudrate waits for a command of the station before going back to the previous one, and cycles
+// without acknowledgment before falling back to the default baudrate with automatic detection
+#define COM_BAUDRATE_CONFIRM_CYCLES             (2u)
+#define COM_BAUDRATE_FALLBACK_CYCLES            (3u)
+
+// Frame types sent to the station
+typedef enum
+{
+    COM_FRAME_MEASUREMENT = 0x01u,
+    COM_FRAME_HEARTBEAT   = 0x02u,
+    COM_FRAME_LOG         = 0x03u,
+    // Latency in microseconds from HAL_Init (not from the reset) to the first measurement, and reset cause
+    COM_FRAME_BOOT        = 0x04u,
+    COM_FRAME_SENSOR_ERROR= 0x05u,
+    COM_FRAME_CRASH       = 0x06u,
+    COM_FRAME_MEASUREMENT_RAW= 0x07u,
+    COM_FRAME_MEASUREMENT_FINE= 0x08u,
+    COM_FRAME_STATS       = 0x09u,
+    COM_FRAME_ALARM       = 0x0Au,
+    COM_FRAME_FUSION      = 0x0Bu,
+    COM_FRAME_IDENTITY    = 0x0Cu,
+    COM_FRAME_QUALITY     = 0x0Du,
+    COM_FRAME_PROFILE     = 0x10u,
+    COM_FRAME_TRACE       = 0x11u,
+    COM_FRAME_MEMORY      = 0x13u,
+    COM_FRAME_CONFIG      = 0x14u,
+    COM_FRAME_DIAG        = 0x17u,
+    COM_FRAME_TIME        = 0x18u,
+    COM_FRAME_BAUDRATE    = 0x19u,
+} com_frame_e;
+
+// Command types received from the station
+typedef enum
+{
+    // No payload for a measurement, the sequence number of the frame (1 byte) for a log frame
+    COM_COMMAND_ACK       = 0x01u,
+    COM_COMMAND_PROFILE   = 0x10u,
+    COM_COMMAND_TRACE     = 0x11u,
+    COM_COMMAND_TRACE_MASK= 0x12u,
+    COM_COMMAND_MEMORY    = 0x13u,
+    COM_COMMAND_CONFIG    = 0x14u,
+    COM_COMMAND_CONFIG_SET= 0x15u,
+    COM_COMMAND_RESET     = 0x16u,
+    COM_COMMAND_DIAG      = 0x17u,
+    COM_COMMAND_TIME      = 0x18u,
+    COM_COMMAND_BAUDRATE  = 0x19u,
+} com_command_e;
+
+// Command received from the station
+typedef struct
+{
+    uint8_t type;
+    uint8_t size;
+    uint8_t payload[COM_COMMAND_PAYLOAD_SIZE];
+    uint64_t time_us;                           // Local time at the reception of the last byte
+} com_command_t;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : com_send_frame                                                                        *
+// Description      : Send a frame to the station.                                                          *
+// Argument         : (com_frame_e) i_type: Type of the frame                                               *
+//                  : (const uint8_t*) i_p_payload: Pointer to the payload                                  *
+//                  : (uint8_t) i_size: Size of the payload in bytes                                        *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+status_e com_send_frame(com_frame_e i_type, const uint8_t* i_p_payload, uint8_t i_size);
+
+// **********************************************************************************************************
+// Function name    : com_receive_byte                                                                      *
+// Description      : Feed a byte received from the station to the command parser (called from the ISR).    *
+// Argument         : (uint8_t) i_byte: Received byte                                                       *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void com_receive_byte(uint8_t i_byte);
+
+// **********************************************************************************************************
+// Function name    : com_get_command                                                                       *
+// Description      : Get the last complete command received from the station.                              *
+// Argument         : (com_command_t*) o_p_command: Pointer to the command                                  *
+// Return value     : (bool_e) : TRUE if a command was available, FALSE otherwise                           *
+// **********************************************************************************************************
+bool_e com_get_command(com_command_t* o_p_command);
+
+#if COM_BAUDRATE_ENABLED
+// **********************************************************************************************************
+// Function name    : com_set_baudrate                                                                      *
+// Description      : Answer a baudrate request of the station with the rate used from now on, then switch  *
+//                    to it. The station must send a command at the new rate before the end of the next     *
+//                    cycle, otherwise the previous rate is restored.                                       *
+// Argument         : (uint32_t) i_baudrate: Requested baudrate                                             *
+// Return value     : (status_e) : STATUS_ERROR if the baudrate is refused, the rate is then unchanged      *
+// **********************************************************************************************************
+status_e com_set_baudrate(uint32_t i_baudrate);
+
+// **********************************************************************************************************
+// Function name    : com_tick                                                                              *
+// Description      : Supervise the baudrate once per cycle: restore the previous rate if the new one is    *
+//                    not confirmed, fall back to the default rate with automatic detection when the link   *
+//                    is lost.                                                                              *
+// Argument         : (bool_e) i_link_up: TRUE if the station acknowledged the last measurement             *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void com_tick(bool_e i_link_up);
+#else
+// Left out of the build
+#define com_set_baudrate(baudrate)              ((void) (baudrate))
+#define com_tick(link_up)                       ((void) 0)
+#endif
+
+// **********************************************************************************************************
+// Function name    : com_crc8                                                                              *
+// Description      : Compute the CRC8 of a buffer (polynomial 0x31, init 0xFF).                            *
+// Argument         : (uint8_t) i_crc: Initial CRC value                                                    *
+//                  : (const uint8_t*) i_p_data: Pointer to the data                                        *
+//                  : (size_t) i_size: Size of the data in bytes                                            *
+// Return value     : (uint8_t) : CRC value                                                                 *
+// **********************************************************************************************************
+uint8_t com_crc8(uint8_t i_crc, const uint8_t* i_p_data, size_t i_size);
+
+// **********************************************************************************************************
+// Function name    : com_put_u16                                                                           *
+// Description      : Write a 16 bits value in little endian in a payload.                                  *
+// Argument         : (uint8_t*) o_p_data: Pointer to the payload                                           *
+//                  : (uint16_t) i_value: Value to write                                                    *
+// Return value     : (uint8_t*) : Pointer to the byte following the value                                  *
+// **********************************************************************************************************
+uint8_t* com_put_u16(uint8_t* o_p_data, uint16_t i_value);
+
+// **********************************************************************************************************
+// Function name    : com_put_u32                                                                           *
+// Description      : Write a 32 bits value in little endian in a payload.                                  *
+// Argument         : (uint8_t*) o_p_data: Pointer to the payload                                           *
+//                  : (uint32_t) i_value: Value to write                                                    *
+// Return value     : (uint8_t*) : Pointer to the byte following the value                                  *
+// **********************************************************************************************************
+uint8_t* com_put_u32(uint8_t* o_p_data, uint32_t i_value);
+
+// **********************************************************************************************************
+// Function name    : com_get_u32                                                                           *
+// Description      : Read a 32 bits value in little endian from a payload.                                 *
+// Argument         : (const uint8_t*) i_p_data: Pointer to the payload                                     *
+// Return value     : (uint32_t) : Value read                                                               *
+// **********************************************************************************************************
+uint32_t com_get_u32(const uint8_t* i_p_data);
+
+# endif // _COM_H_
@@ -0,0 +1,108 @@
+// **********************************************************************************************************
+// File name         : config.h                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Runtime parameters kept in a log-structured flash store                              *
+// **********************************************************************************************************
+# ifndef _CONFIG_H_
+# define _CONFIG_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Parameter keys, the key is also the index of the parameter in the RAM copy
+typedef enum
+{
+    CONFIG_KEY_TIM_PRESCALER = 0u,              // Wakeup timer prescaler
+    CONFIG_KEY_TIM_PERIOD,                      // Wakeup timer period
+    CONFIG_KEY_PRECISION,                       // Measurement precision (sht4x_precision_e)
+    CONFIG_KEY_SENSOR_ADDRESS,                  // Sensor address (sht4x_address_e)
+    CONFIG_KEY_BAUDRATE,                        // Communication UART baudrate
+    CONFIG_KEY_I2C_TIMING,                      // I2C timing register value, 0 to compute it from the speed
+    CONFIG_KEY_FORMAT,                          // Measurement frame format (task_format_e)
+    CONFIG_KEY_STATS_WINDOW,                    // Cycles per statistics summary, 0 to send every sample
+    CONFIG_KEY_ALARM_TEMPERATURE_HIGH,          // High temperature alarm (0.1 degree Celsius, 16 bits signed)
+    CONFIG_KEY_ALARM_TEMPERATURE_LOW,           // Low temperature alarm (0.1 degree Celsius, 16 bits signed)
+    CONFIG_KEY_ALARM_HUMIDITY_HIGH,             // High humidity alarm (0.1 %RH, 16 bits signed)
+    CONFIG_KEY_ALARM_HUMIDITY_LOW,              // Low humidity alarm (0.1 %RH, 16 bits signed)
+    CONFIG_KEY_ALARM_TEMPERATURE_RATE,          // Temperature rate alarm (0.1 degree Celsius per minute)
+    CONFIG_KEY_ALARM_HUMIDITY_RATE,             // Humidity rate alarm (0.1 %RH per minute)
+    CONFIG_KEY_ALARM_HYSTERESIS,                // Level alarm hysteresis (0.1 unit)
+    CONFIG_KEY_FUSION_SENSORS,                  // Fused sensors (bit n for address n), 0 for one sensor
+    CONFIG_KEY_CALIBRATION_SERIAL_0,            // Serial calibrated by slot 0, 0 if free
+    CONFIG_KEY_CALIBRATION_TEMPERATURE_0,       // Temperature calibration of slot 0 (gain and offset)
+    CONFIG_KEY_CALIBRATION_HUMIDITY_0,          // Humidity calibration of slot 0 (gain and offset)
+    CONFIG_KEY_CALIBRATION_SERIAL_1,            // Serial calibrated by slot 1, 0 if free
+    CONFIG_KEY_CALIBRATION_TEMPERATURE_1,       // Temperature calibration of slot 1 (gain and offset)
+    CONFIG_KEY_CALIBRATION_HUMIDITY_1,          // Humidity calibration of slot 1 (gain and offset)
+    CONFIG_KEY_CALIBRATION_SERIAL_2,            // Serial calibrated by slot 2, 0 if free
+    CONFIG_KEY_CALIBRATION_TEMPERATURE_2,       // Temperature calibration of slot 2 (gain and offset)
+    CONFIG_KEY_CALIBRATION_HUMIDITY_2,          // Humidity calibration of slot 2 (gain and offset)
+    CONFIG_KEY_TX_SLOT_COUNT,                   // Transmission slots per wakeup period, 0 to disable
+    CONFIG_KEY_TX_SLOT,                         // Transmission slot, 0xFF to derive it from the serial
+    CONFIG_KEY_I2C_SPEED,                       // I2C bus speed (Hz)
+    CONFIG_KEY_ENERGY_CURRENT_SLEEP,            // Current drawn while sleeping (uA), first of energy_state_e
+    CONFIG_KEY_ENERGY_CURRENT_ACTIVE,           // Current drawn while active (uA)
+    CONFIG_KEY_ENERGY_CURRENT_I2C,              // Current drawn by the I2C transfers (uA)
+    CONFIG_KEY_ENERGY_CURRENT_UART,             // Current drawn by the UART transmission (uA)
+    CONFIG_KEY_ENERGY_CURRENT_CONVERSION,       // Current drawn by the sensor conversion (uA)
+    CONFIG_KEY_ENERGY_CURRENT_HEATER,           // Current drawn by the sensor heater (uA)
+    CONFIG_KEY_COUNT,
+} config_key_e;
+
+// Read a parameter from the RAM copy
+#define CONFIG_GET(key)                         (ge_config[(key)])
+
+// Calibration slots, keyed by the sensor serial, each made of a serial, temperature and humidity key. A
+// calibration holds the gain in Q15 in the upper 16 bits and the offset in 0.01 unit (two's complement) in
+// the lower 16 bits: calibrated value = gain . datasheet value + offset
+#define CONFIG_CALIBRATION_SLOTS                (3u)
+#define CONFIG_CALIBRATION_KEYS                 (3u)
+#define CONFIG_CALIBRATION_NONE                 (0x80000000u)
+#define CONFIG_CALIBRATION_GAIN(value)          ((uint16_t) ((value) >> 16))
+#define CONFIG_CALIBRATION_OFFSET(value)        ((int16_t) ((value) & 0xFFFFu))
+
+// **********************************************************************************************************
+//                                           Public variables                                               *
+// **********************************************************************************************************
+// RAM copy of the parameters, loaded once at boot
+extern uint32_t ge_config[CONFIG_KEY_COUNT];
+
+// Wakeup period in microseconds, derived from the timer parameters at boot
+extern uint32_t ge_config_period_us;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : config_init                                                                           *
+// Description      : Load the defaults then the records stored in flash into the RAM copy, the copy is     *
+//                    kept as is after a watchdog or software reset.                                        *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void config_init(void);
+
+// **********************************************************************************************************
+// Function name    : config_set                                                                            *
+// Description      : Store a parameter, the hardware parameters take effect at the next reset.             *
+// Argument         : (config_key_e) i_key: Parameter key                                                   *
+//                  : (uint32_t) i_value: Parameter value                                                   *
+// Return value     : (status_e) : STATUS_ERROR if the key or the value is not valid                        *
+// **********************************************************************************************************
+status_e config_set(config_key_e i_key, uint32_t i_value);
+
+// **********************************************************************************************************
+// Function name    : config_report                                                                         *
+// Description      : Send the parameters to the station.                                                   *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void config_report(void);
+
+# endif // _CONFIG_H_
@@ -32,4 +32,7 @@ typedef enum
     STATUS_TIMEOUT,
 } status_e;
 
+// Variable left out of the startup .data/.bss initialization, it must be written before being read
+#define NOINIT                                  __attribute__((section(".noinit")))
+
 # endif // _DEFINITIONS_H_
@@ -0,0 +1,91 @@
+// **********************************************************************************************************
+// File name         : diag.h                                                                               *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Health and diagnostic counters, kept over the warm resets                            *
+// **********************************************************************************************************
+# ifndef _DIAG_H_
+# define _DIAG_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Counters, in the order of the diagnostic frame
+typedef enum
+{
+    DIAG_COUNTER_WAKEUPS = 0u,                  // Wakeups of the main loop
+    DIAG_COUNTER_SAMPLES,                       // Samples kept
+    DIAG_COUNTER_I2C_ERRORS,                    // Failed I2C transfers
+    DIAG_COUNTER_I2C_NACKS,                     // I2C transfers not acknowledged
+    DIAG_COUNTER_CRC_ERRORS,                    // Sensor reads failing their CRC
+    DIAG_COUNTER_RETRIES,                       // Measurement attempts after a failure
+    DIAG_COUNTER_UART_TX_ERRORS,                // Frames whose transmission failed
+    DIAG_COUNTER_HEATER_PULSES,                 // Heater pulses fired
+    DIAG_COUNTER_WATCHDOG_RESETS,               // Watchdog resets
+    DIAG_COUNTER_ACTIVE_MS,                     // Time spent in the task
+    DIAG_COUNTER_SLEEP_MS,                      // Time spent between the tasks
+    DIAG_COUNTER_COUNT,
+} diag_counter_e;
+
+// Diagnostic frame size: the counters in 32 bits
+#define DIAG_REPORT_SIZE                        (DIAG_COUNTER_COUNT * 4u)
+
+// Set to 0 to leave the health counters out of the build
+#ifndef DIAG_ENABLED
+#define DIAG_ENABLED                            (1u)
+#endif
+
+#if DIAG_ENABLED
+// Count an event: a single increment, usable on the hot path
+#define DIAG_COUNT(counter)                     (ge_diag_counters[(counter)]++)
+#else
+#define DIAG_COUNT(counter)                     ((void) 0)
+#endif
+
+#if DIAG_ENABLED
+// **********************************************************************************************************
+//                                           Public variables                                               *
+// **********************************************************************************************************
+// Counters, cleared at the power-on reset only
+extern uint32_t ge_diag_counters[DIAG_COUNTER_COUNT];
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : diag_init                                                                             *
+// Description      : Keep the counters over a watchdog or software reset, clear them otherwise, and count  *
+//                    the watchdog reset.                                                                   *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void diag_init(void);
+
+// **********************************************************************************************************
+// Function name    : diag_add_time                                                                         *
+// Description      : Add a duration to a time counter, the part below one millisecond is carried over.     *
+// Argument         : (diag_counter_e) i_counter: DIAG_COUNTER_ACTIVE_MS or DIAG_COUNTER_SLEEP_MS           *
+//                  : (uint32_t) i_duration_us: Duration in microseconds                                    *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void diag_add_time(diag_counter_e i_counter, uint32_t i_duration_us);
+
+// **********************************************************************************************************
+// Function name    : diag_report                                                                           *
+// Description      : Send the counters in a diagnostic frame.                                              *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void diag_report(void);
+#else
+#define diag_init()                             ((void) 0)
+#define diag_add_time(counter, duration_us)     ((void) (duration_us))
+#define diag_report()                           ((void) 0)
+#endif
+
+# endif // _DIAG_H_
@@ -0,0 +1,103 @@
+// **********************************************************************************************************
+// File name         : energy.h                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Energy-per-sample estimator and battery life model                                   *
+//                   : This module has no hardware dependency so that it can also be built on the host      *
+//                   : (see tools/energy_sim.c).                                                            *
+// **********************************************************************************************************
+# ifndef _ENERGY_H_
+# define _ENERGY_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+#include "com.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the energy estimate out of the build, the heartbeat then reports 0
+#ifndef ENERGY_ENABLED
+#define ENERGY_ENABLED                          (1u)
+#endif
+
+// Battery capacity
+#define ENERGY_BATTERY_CAPACITY_MAH             (1000u)
+
+// Default current drawn by each contribution (the contributions add up, e.g. the MCU is active while the
+// sensor converts), the currents are parameters (CONFIG_KEY_ENERGY_CURRENT_SLEEP and the next keys, in the
+// order of energy_state_e) and take effect at the next cycle
+#define ENERGY_CURRENT_SLEEP_UA                 (3500u)
+#define ENERGY_CURRENT_ACTIVE_UA                (12000u)
+#define ENERGY_CURRENT_I2C_UA                   (700u)
+#define ENERGY_CURRENT_UART_UA                  (1000u)
+#define ENERGY_CURRENT_CONVERSION_UA            (500u)
+#define ENERGY_CURRENT_HEATER_UA                (60000u)
+#define ENERGY_CURRENT_MAX_UA                   (1000000u)
+
+// Bus time of the transfers, used by the firmware and the simulator alike: an I2C transfer of size bytes
+// after the address byte (8 data bits and the acknowledge per byte) and a frame of size payload bytes
+#define ENERGY_I2C_BITS_PER_BYTE                (9u)
+#define ENERGY_I2C_US(size, speed_hz)           ((((uint32_t) (size) + 1u) * ENERGY_I2C_BITS_PER_BYTE *       \
+                                                  1000000u) / (speed_hz))
+#define ENERGY_FRAME_US(size, baudrate)         ((((uint32_t) (size) + COM_FRAME_OVERHEAD) *                  \
+                                                  COM_BITS_PER_BYTE * 1000000u) / (baudrate))
+
+// Contributions to the consumption
+typedef enum
+{
+    ENERGY_STATE_SLEEP = 0u,
+    ENERGY_STATE_ACTIVE,
+    ENERGY_STATE_I2C,
+    ENERGY_STATE_UART,
+    ENERGY_STATE_CONVERSION,
+    ENERGY_STATE_HEATER,
+    ENERGY_STATE_COUNT,
+} energy_state_e;
+
+// Energy report
+typedef struct
+{
+    uint32_t consumed_uah;
+    uint32_t average_ua;
+    uint32_t battery_life_h;
+} energy_report_t;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if ENERGY_ENABLED
+// **********************************************************************************************************
+// Function name    : energy_add                                                                            *
+// Description      : Account time spent in a contribution during the current cycle.                        *
+// Argument         : (energy_state_e) i_state: Contribution                                                *
+//                  : (uint32_t) i_duration_us: Duration in microseconds                                    *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void energy_add(energy_state_e i_state, uint32_t i_duration_us);
+
+// **********************************************************************************************************
+// Function name    : energy_cycle_end                                                                      *
+// Description      : Close the current cycle, the time not spent active is accounted as sleep.             *
+// Argument         : (uint32_t) i_cycle_us: Duration of the whole cycle in microseconds                    *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void energy_cycle_end(uint32_t i_cycle_us);
+
+// **********************************************************************************************************
+// Function name    : energy_get_report                                                                     *
+// Description      : Get the consumed charge, the average current and the projected battery life.          *
+// Argument         : (energy_report_t*) o_p_report: Pointer to the report                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void energy_get_report(energy_report_t* o_p_report);
+#else
+// Left out of the build
+#define energy_add(state, duration_us)          ((void) (duration_us))
+#define energy_cycle_end(cycle_us)              ((void) 0)
+#define energy_get_report(report)               (*(report) = (energy_report_t) { 0u })
+#endif
+
+# endif // _ENERGY_H_
@@ -0,0 +1,92 @@
+// **********************************************************************************************************
+// File name         : fault.h                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Fault capture in RAM kept over the reset, reported at the next boot                  *
+// **********************************************************************************************************
+# ifndef _FAULT_H_
+# define _FAULT_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 1 to add the capture of the faults to the build, a fault only resets the node otherwise
+#ifndef FAULT_ENABLED
+#define FAULT_ENABLED                           (0u)
+#endif
+
+// Fault reason: exception number for the exceptions (an unexpected interrupt gives 16 + IRQ number),
+// software reasons above
+typedef enum
+{
+    FAULT_REASON_NMI           = 2u,
+    FAULT_REASON_HARDFAULT     = 3u,
+    FAULT_REASON_SVC           = 11u,
+    FAULT_REASON_PENDSV        = 14u,
+    FAULT_REASON_ERROR_HANDLER = 0x40u,
+    FAULT_REASON_ASSERT        = 0x41u,
+} fault_reason_e;
+
+// Body of an exception handler: pass the stacked frame (main or process stack) to fault_exception
+#define FAULT_EXCEPTION_ENTRY()                 __asm volatile ("movs r0, #4          \n"                       \
+                                                                "mov r1, lr           \n"                       \
+                                                                "tst r0, r1           \n"                       \
+                                                                "beq 1f               \n"                       \
+                                                                "mrs r0, psp          \n"                       \
+                                                                "bl fault_exception   \n"                       \
+                                                                "1:                   \n"                       \
+                                                                "mrs r0, msp          \n"                       \
+                                                                "bl fault_exception   \n")
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if FAULT_ENABLED
+// **********************************************************************************************************
+// Function name    : fault_init                                                                            *
+// Description      : Check the record kept over the reset, clear it after a power-on reset.                *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void fault_init(void);
+#else
+// Left out of the build
+#define fault_init()                            ((void) 0)
+#endif
+
+// **********************************************************************************************************
+// Function name    : fault_exception                                                                       *
+// Description      : Save the stacked PC, LR and xPSR of the faulting context, then reset.                 *
+// Argument         : (const uint32_t*) i_p_frame: Exception stack frame (r0-r3, r12, lr, pc, xpsr)         *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void fault_exception(const uint32_t* i_p_frame) __attribute__((noreturn));
+
+// **********************************************************************************************************
+// Function name    : fault_software                                                                        *
+// Description      : Save a software fault with the address of its caller, then reset.                     *
+// Argument         : (fault_reason_e) i_reason: Fault reason                                               *
+//                  : (uint32_t) i_info: Additional information (assert line), saved in place of xPSR       *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void fault_software(fault_reason_e i_reason, uint32_t i_info) __attribute__((noreturn));
+
+#if FAULT_ENABLED
+// **********************************************************************************************************
+// Function name    : fault_report                                                                          *
+// Description      : Send the crash frame if a fault was saved before the reset, then forget it.           *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void fault_report(void);
+#else
+// Left out of the build
+#define fault_report()                          ((void) 0)
+#endif
+
+# endif // _FAULT_H_
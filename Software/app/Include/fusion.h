@@ -0,0 +1,64 @@
+// **********************************************************************************************************
+// File name         : fusion.h                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Fusion of redundant sensors: median vote, mean of the agreeing sensors and detection *
+//                   : of the sensor which disagrees                                                        *
+// **********************************************************************************************************
+# ifndef _FUSION_H_
+# define _FUSION_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 1 to add the vote between several sensors to the build, the sensor at the configured address is
+// read alone otherwise
+#ifndef FUSION_ENABLED
+#define FUSION_ENABLED                          (0u)
+#endif
+
+// Number of sensors on the bus (one per SHT4x address)
+#define FUSION_SENSOR_COUNT                     (3u)
+
+// Largest distance to the median for a sensor to agree: 1 degree Celsius and 5 %RH (0.1 unit), several
+// times the accuracy of the sensor
+#define FUSION_TEMPERATURE_TOLERANCE            (10)
+#define FUSION_HUMIDITY_TOLERANCE               (50)
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if FUSION_ENABLED
+// **********************************************************************************************************
+// Function name    : fusion_vote                                                                           *
+// Description      : Vote between the valid sensors. With three sensors, the ones further than the         *
+//                    tolerance from the median disagree. With two, both disagree if they are apart: the    *
+//                    faulty one is not known, so both are kept.                                            *
+// Argument         : (const int32_t*) i_p_temperature: Temperature of each sensor (0.1 degree Celsius)     *
+//                  : (const int32_t*) i_p_humidity: Humidity of each sensor (0.1 %RH)                      *
+//                  : (uint8_t) i_valid: Sensors read successfully (bit n for sensor n, at least one)       *
+//                  : (uint8_t*) o_p_used: Sensors to average in the fused sample                           *
+// Return value     : (uint8_t) : Sensors which disagree (bit n for sensor n)                               *
+// **********************************************************************************************************
+uint8_t fusion_vote(const int32_t* i_p_temperature, const int32_t* i_p_humidity, uint8_t i_valid,
+                    uint8_t* o_p_used);
+#else
+// Left out of the build: the only sensor is used and never disagrees
+#define fusion_vote(temperature, humidity, valid, used) ((*(used) = (valid)), 0u)
+#endif
+
+// **********************************************************************************************************
+// Function name    : fusion_mean                                                                           *
+// Description      : Mean of the values of some sensors, rounded to the nearest.                           *
+// Argument         : (const int32_t*) i_p_values: Value of each sensor                                     *
+//                  : (uint8_t) i_sensors: Averaged sensors (bit n for sensor n, at least one)              *
+// Return value     : (int32_t) : Mean                                                                      *
+// **********************************************************************************************************
+int32_t fusion_mean(const int32_t* i_p_values, uint8_t i_sensors);
+
+# endif // _FUSION_H_
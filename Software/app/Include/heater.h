@@ -0,0 +1,89 @@
+// **********************************************************************************************************
+// File name         : heater.h                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Heater manager: dries the sensor when the humidity stays high, within the heater     *
+//                   : duty cycle limit, and flags the samples distorted by the heating                     *
+// **********************************************************************************************************
+# ifndef _HEATER_H_
+# define _HEATER_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+#include "sht4x_driver.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the condensation recovery out of the build
+#ifndef HEATER_ENABLED
+#define HEATER_ENABLED                          (1u)
+#endif
+
+// Humidity above which the sensor is considered wet (0.1 %RH) and time it must stay there before a pulse
+#define HEATER_HUMIDITY_HIGH                    (950u)
+#define HEATER_TRIGGER_US                       (600000000u)
+
+// Maximum heater duty cycle (datasheet: 10 %), the budget is capped to one long pulse
+#define HEATER_DUTY_DIVIDER                     (10u)
+#define HEATER_BUDGET_MAX_US                    (1000000u)
+
+// Time for the sensor to cool down after a pulse, the samples taken meanwhile are discarded
+#define HEATER_SETTLE_US                        (20000000u)
+
+// Heater pulse
+typedef struct
+{
+    sht4x_heater_power_e power;
+    sht4x_heater_duration_e duration;
+    uint32_t on_time_us;                        // Heating time, without the measurement at the end
+} heater_pulse_t;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if HEATER_ENABLED
+// **********************************************************************************************************
+// Function name    : heater_tick                                                                           *
+// Description      : Account the time elapsed since the previous cycle, called once per cycle.             *
+// Argument         : (uint32_t) i_elapsed_us: Time elapsed in microseconds                                 *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void heater_tick(uint32_t i_elapsed_us);
+
+// **********************************************************************************************************
+// Function name    : heater_is_settling                                                                    *
+// Description      : Tell whether the sensor is still cooling down after a pulse.                          *
+// Argument         : None                                                                                  *
+// Return value     : (bool_e) : TRUE if the samples are distorted by the heating and must be discarded     *
+// **********************************************************************************************************
+bool_e heater_is_settling(void);
+
+// **********************************************************************************************************
+// Function name    : heater_request                                                                        *
+// Description      : Check a trusted sample and choose a pulse if the humidity has stayed high. The pulse  *
+//                    escalates while the humidity stays high after the previous ones.                      *
+// Argument         : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+//                  : (heater_pulse_t*) o_p_pulse: Pulse to fire                                            *
+// Return value     : (bool_e) : TRUE if the pulse must be fired now                                        *
+// **********************************************************************************************************
+bool_e heater_request(uint16_t i_humidity, heater_pulse_t* o_p_pulse);
+
+// **********************************************************************************************************
+// Function name    : heater_fired                                                                          *
+// Description      : Account a fired pulse: duty cycle budget, settling time and escalation.               *
+// Argument         : (const heater_pulse_t*) i_p_pulse: Fired pulse                                        *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void heater_fired(const heater_pulse_t* i_p_pulse);
+#else
+// Left out of the build
+#define heater_tick(elapsed_us)                 ((void) 0)
+#define heater_is_settling()                    (FALSE)
+#define heater_request(humidity, pulse)         (FALSE)
+#define heater_fired(pulse)                     ((void) 0)
+#endif
+
+# endif // _HEATER_H_
@@ -14,6 +14,15 @@
 #include "stm32f0xx_hal.h"  
 #include "hw_config.h"  
 
+// **********************************************************************************************************
+//                                           Public variables                                               *
+// **********************************************************************************************************
+// Set by the timer interrupt when the task has to run
+extern volatile bool_e ge_task_request;
+
+// Set by the timer interrupt at every period when the watchdog has to be refreshed
+extern volatile bool_e ge_wdg_request;
+
 // **********************************************************************************************************
 //                                           Public fuctions                                                *
 // **********************************************************************************************************
@@ -0,0 +1,51 @@
+// **********************************************************************************************************
+// File name         : memory.h                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : RAM usage monitor (stack high-water mark, heap and static RAM usage)                 *
+// **********************************************************************************************************
+# ifndef _MEMORY_H_
+# define _MEMORY_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the RAM usage report out of the build
+#ifndef MEMORY_ENABLED
+#define MEMORY_ENABLED                          (1u)
+#endif
+
+// Pattern painted by the startup code over the stack reservation (see startup_stm32f030f4px.s)
+#define MEMORY_PAINT_PATTERN                    (0xCDCDCDCDu)
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if MEMORY_ENABLED
+// **********************************************************************************************************
+// Function name    : memory_get_stack_peak                                                                 *
+// Description      : Get the deepest stack usage since reset, found from the unpainted stack reservation.  *
+// Argument         : None                                                                                  *
+// Return value     : (uint32_t) : Peak stack usage in bytes, the reservation if the stack went past it     *
+// **********************************************************************************************************
+uint32_t memory_get_stack_peak(void);
+
+// **********************************************************************************************************
+// Function name    : memory_report                                                                         *
+// Description      : Send the RAM usage in a memory frame.                                                 *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void memory_report(void);
+#else
+// Left out of the build
+#define memory_get_stack_peak()                 (0u)
+#define memory_report()                         ((void) 0)
+#endif
+
+# endif // _MEMORY_H_
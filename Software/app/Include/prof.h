@@ -0,0 +1,79 @@
+// **********************************************************************************************************
+// File name         : prof.h                                                                               *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Per-phase timing instrumentation of the measurement cycle (DEBUG builds only)        *
+// **********************************************************************************************************
+# ifndef _PROF_H_
+# define _PROF_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Measured phases of the cycle
+typedef enum
+{
+    PROF_PHASE_WAKEUP = 0u,
+    PROF_PHASE_CLOCK_RESTORE,
+    PROF_PHASE_I2C_WRITE,
+    PROF_PHASE_CONVERSION_WAIT,
+    PROF_PHASE_I2C_READ,
+    PROF_PHASE_CONVERT,
+    PROF_PHASE_UART_TX,
+    PROF_PHASE_DEW_POINT,                       // Derived values, one phase per kernel
+    PROF_PHASE_ABSOLUTE_HUMIDITY,
+    PROF_PHASE_HEAT_INDEX,
+    PROF_PHASE_COUNT,
+} prof_phase_e;
+
+// Set to 0 to leave the instrumentation out of the build
+#ifndef PROF_ENABLED
+#define PROF_ENABLED                            (1u)
+#endif
+
+// Instrumentation macros, they compile away to nothing when the instrumentation is left out
+#if PROF_ENABLED
+#define PROF_START(phase)                       prof_start(phase)
+#define PROF_STOP(phase)                        prof_stop(phase)
+#define PROF_REPORT()                           prof_report()
+#else
+#define PROF_START(phase)
+#define PROF_STOP(phase)
+#define PROF_REPORT()
+#endif
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if PROF_ENABLED
+// **********************************************************************************************************
+// Function name    : prof_start                                                                            *
+// Description      : Timestamp the start of a phase.                                                       *
+// Argument         : (prof_phase_e) i_phase: Phase starting                                                *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void prof_start(prof_phase_e i_phase);
+
+// **********************************************************************************************************
+// Function name    : prof_stop                                                                             *
+// Description      : Timestamp the end of a phase and update its min/max/mean.                             *
+// Argument         : (prof_phase_e) i_phase: Phase ending                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void prof_stop(prof_phase_e i_phase);
+
+// **********************************************************************************************************
+// Function name    : prof_report                                                                           *
+// Description      : Send the min/max/mean of each phase (in microseconds) in a profile frame.             *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void prof_report(void);
+#endif
+
+# endif // _PROF_H_
@@ -0,0 +1,69 @@
+// **********************************************************************************************************
+// File name         : psychro.h                                                                            *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Derived psychrometric values with integer-only kernels                               *
+//                   : This module has no hardware dependency so that it can also be built on the host      *
+//                   : (see tools/psychro_sweep.c).                                                         *
+// **********************************************************************************************************
+# ifndef _PSYCHRO_H_
+# define _PSYCHRO_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the derived values out of the build, they are then sent as 0
+#ifndef PSYCHRO_ENABLED
+#define PSYCHRO_ENABLED                         (1u)
+#endif
+
+// Input range, the values outside are clamped (0.1 degree Celsius and 0.1 %RH)
+#define PSYCHRO_TEMPERATURE_MIN                 (-450)
+#define PSYCHRO_TEMPERATURE_MAX                 (1300)
+#define PSYCHRO_HUMIDITY_MIN                    (1u)
+#define PSYCHRO_HUMIDITY_MAX                    (1000u)
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if PSYCHRO_ENABLED
+// **********************************************************************************************************
+// Function name    : psychro_dew_point                                                                     *
+// Description      : Dew point from the Magnus formula (b = 17.62, c = 243.12 degree Celsius).             *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+// Return value     : (int16_t) : Dew point (0.1 degree Celsius)                                            *
+// **********************************************************************************************************
+int16_t psychro_dew_point(int16_t i_temperature, uint16_t i_humidity);
+
+// **********************************************************************************************************
+// Function name    : psychro_absolute_humidity                                                             *
+// Description      : Absolute humidity from the Magnus saturation pressure and the ideal gas law.          *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+// Return value     : (uint16_t) : Absolute humidity (0.01 g/m3, saturated at 655.35 g/m3)                  *
+// **********************************************************************************************************
+uint16_t psychro_absolute_humidity(int16_t i_temperature, uint16_t i_humidity);
+
+// **********************************************************************************************************
+// Function name    : psychro_heat_index                                                                    *
+// Description      : Heat index from the NWS algorithm (Steadman simple formula, Rothfusz regression and   *
+//                    its adjustments).                                                                     *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+// Return value     : (int16_t) : Heat index (0.1 degree Celsius)                                           *
+// **********************************************************************************************************
+int16_t psychro_heat_index(int16_t i_temperature, uint16_t i_humidity);
+#else
+// Left out of the build
+#define psychro_dew_point(temperature, humidity) ((int16_t) 0)
+#define psychro_absolute_humidity(temperature, humidity) ((uint16_t) 0u)
+#define psychro_heat_index(temperature, humidity) ((int16_t) 0)
+#endif
+
+# endif // _PSYCHRO_H_
@@ -0,0 +1,127 @@
+// **********************************************************************************************************
+// File name         : quality.h                                                                            *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Signal quality monitor of each sensor: stuck readings, impossible slew rates and CRC *
+//                   : error rate, checked in constant time per sample                                      *
+// **********************************************************************************************************
+# ifndef _QUALITY_H_
+# define _QUALITY_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the signal quality monitor out of the build, every sample is then accepted
+#ifndef QUALITY_ENABLED
+#define QUALITY_ENABLED                         (1u)
+#endif
+
+// Quality flags of a sensor
+#define QUALITY_STUCK                           (1u << 0)
+#define QUALITY_SPIKE                           (1u << 1)
+#define QUALITY_CRC_RATE                        (1u << 2)
+
+// Identical raw words (both values) over this many samples: the sensor is stuck. The noise of the sensor moves
+// the raw words at every sample, even in a steady room
+#define QUALITY_STUCK_SAMPLES                   (10u)
+
+// Fastest physical change (0.1 unit per second): the response time of the sensor is several seconds
+#define QUALITY_TEMPERATURE_SLEW                (20u)
+#define QUALITY_HUMIDITY_SLEW                   (100u)
+
+// CRC error rate: averaged over about 2^5 reads, flagged above 10 % and cleared below 5 % (Q16)
+#define QUALITY_CRC_SHIFT                       (5u)
+#define QUALITY_CRC_RATE_HIGH                   (6554u)
+#define QUALITY_CRC_RATE_LOW                    (3277u)
+
+// Counters of a sensor, saturated
+typedef struct
+{
+    uint16_t stuck;                             // Samples rejected as stuck
+    uint16_t spikes;                            // Samples rejected for an impossible slew rate
+    uint16_t crc_errors;                        // Reads failing their CRC
+} quality_counters_t;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if QUALITY_ENABLED
+// **********************************************************************************************************
+// Function name    : quality_init                                                                          *
+// Description      : Convert the slew limits to the wakeup period.                                         *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void quality_init(void);
+
+// **********************************************************************************************************
+// Function name    : quality_read                                                                          *
+// Description      : Account a read of a sensor in its CRC error rate.                                     *
+// Argument         : (uint8_t) i_sensor: Sensor address                                                    *
+//                  : (bool_e) i_crc_error: TRUE if the read failed its CRC                                 *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void quality_read(uint8_t i_sensor, bool_e i_crc_error);
+
+// **********************************************************************************************************
+// Function name    : quality_check                                                                         *
+// Description      : Check a sample of a sensor. A spike is a sample far from both the last accepted and   *
+//                    the previous sample: a lasting step is accepted from its second sample.               *
+// Argument         : (uint8_t) i_sensor: Sensor address                                                    *
+//                  : (uint16_t) i_raw_temperature: Raw temperature word                                    *
+//                  : (uint16_t) i_raw_humidity: Raw humidity word                                          *
+//                  : (int32_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (int32_t) i_humidity: Humidity (0.1 %RH)                                              *
+// Return value     : (bool_e) : TRUE if the sample can be used, FALSE if it is rejected                    *
+// **********************************************************************************************************
+bool_e quality_check(uint8_t i_sensor, uint16_t i_raw_temperature, uint16_t i_raw_humidity,
+                     int32_t i_temperature, int32_t i_humidity);
+
+// **********************************************************************************************************
+// Function name    : quality_missed                                                                        *
+// Description      : Signal a cycle without sample of a sensor, the slew is not checked across the gap.    *
+// Argument         : (uint8_t) i_sensor: Sensor address                                                    *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void quality_missed(uint8_t i_sensor);
+
+// **********************************************************************************************************
+// Function name    : quality_get_changed                                                                   *
+// Description      : Get the sensors whose flags changed since the last call.                              *
+// Argument         : None                                                                                  *
+// Return value     : (uint8_t) : Sensors whose flags changed (bit n for the address n)                     *
+// **********************************************************************************************************
+uint8_t quality_get_changed(void);
+
+// **********************************************************************************************************
+// Function name    : quality_get_flags                                                                     *
+// Description      : Get the quality flags of a sensor.                                                    *
+// Argument         : (uint8_t) i_sensor: Sensor address                                                    *
+// Return value     : (uint8_t) : Quality flags                                                             *
+// **********************************************************************************************************
+uint8_t quality_get_flags(uint8_t i_sensor);
+
+// **********************************************************************************************************
+// Function name    : quality_get_counters                                                                  *
+// Description      : Get the counters of a sensor.                                                         *
+// Argument         : (uint8_t) i_sensor: Sensor address                                                    *
+// Return value     : (const quality_counters_t*) : Counters                                                *
+// **********************************************************************************************************
+const quality_counters_t* quality_get_counters(uint8_t i_sensor);
+#else
+// Left out of the build
+#define quality_init()                          ((void) 0)
+#define quality_read(sensor, crc_error)         ((void) 0)
+#define quality_check(sensor, raw_temperature, raw_humidity, temperature, humidity) (TRUE)
+#define quality_missed(sensor)                  ((void) 0)
+#define quality_get_changed()                   (0u)
+#define quality_get_flags(sensor)               (0u)
+#define quality_get_counters(sensor)            ((const quality_counters_t*) 0)
+#endif
+
+# endif // _QUALITY_H_
@@ -0,0 +1,102 @@
+// **********************************************************************************************************
+// File name         : sample_log.h                                                                         *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Flash-backed circular log of the samples the station did not acknowledge             *
+// **********************************************************************************************************
+# ifndef _SAMPLE_LOG_H_
+# define _SAMPLE_LOG_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the sample log out of the build, the samples not acknowledged are then lost
+#ifndef SAMPLE_LOG_ENABLED
+#define SAMPLE_LOG_ENABLED                      (1u)
+#endif
+
+// Block of delta encoded samples, programmed at once in flash (32 bytes): the first sample in full, then
+// up to 9 int8 deltas, so at most 10 samples
+// The log frame carries a block without its state field, its reserved byte holding the sequence number of the
+// frame. The samples of a block are evenly spaced: sample n was taken at timestamp + n . interval
+#define SAMPLE_LOG_BLOCK_DELTAS                 (9u)
+
+typedef struct
+{
+    uint16_t state;                             // 0xFFFF: not sent yet, 0x0000: sent to the station
+    uint8_t count;                              // Number of samples (0xFF: erased block)
+    uint8_t reserved;
+    uint32_t timestamp;                         // First sample (ms, see clock_get_ms)
+    uint16_t interval;                          // Time between two samples (ms)
+    int16_t temperature;                        // First sample (0.1 degree Celsius)
+    uint16_t humidity;                          // First sample (0.1 %RH)
+    int8_t deltas[SAMPLE_LOG_BLOCK_DELTAS][2];  // Temperature and humidity deltas to the previous sample
+} sample_log_block_t;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if SAMPLE_LOG_ENABLED
+// **********************************************************************************************************
+// Function name    : sample_log_init                                                                       *
+// Description      : Find the write and read positions of the log in flash.                                *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void sample_log_init(void);
+
+// **********************************************************************************************************
+// Function name    : sample_log_append                                                                     *
+// Description      : Append a sample to the log. The flash is left to sample_log_flush: a closed block is  *
+//                    queued for it, unless the queue is full and its oldest block is programmed at once.   *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Humidity (0.1 %RH)                                             *
+//                  : (uint32_t) i_timestamp: Time of the sample (ms, see clock_get_ms)                     *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void sample_log_append(int16_t i_temperature, uint16_t i_humidity, uint32_t i_timestamp);
+
+// **********************************************************************************************************
+// Function name    : sample_log_flush                                                                      *
+// Description      : Do the flash operations of the cycle: mark the blocks sent,                           *
+//                    then erase the next page or program the oldest closed block (both when the queue is   *
+//                    full). Called once per cycle, after sample_log_append.                                *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void sample_log_flush(void);
+
+// **********************************************************************************************************
+// Function name    : sample_log_send                                                                       *
+// Description      : Send the next block of the backlog to the station. One block is sent at a time: it    *
+//                    leaves the backlog when acknowledged, and is sent again when the acknowledgment does  *
+//                    not come within the cycle (see sample_log_flush).                                     *
+// Argument         : None                                                                                  *
+// Return value     : (bool_e) : TRUE if the next block can be sent right away, FALSE when waiting for an   *
+//                    acknowledgment or when the backlog is empty                                           *
+// **********************************************************************************************************
+bool_e sample_log_send(void);
+
+// **********************************************************************************************************
+// Function name    : sample_log_ack                                                                        *
+// Description      : Take the acknowledgment of the station (command 0x01 with a 1-byte payload) for the   *
+//                    block sent. It is ignored unless it echoes the sequence number of the last log frame. *
+// Argument         : (uint8_t) i_sequence: Sequence number echoed by the station                           *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void sample_log_ack(uint8_t i_sequence);
+#else
+// Left out of the build
+#define sample_log_init()                       ((void) 0)
+#define sample_log_append(temperature, humidity, timestamp) ((void) 0)
+#define sample_log_flush()                      ((void) 0)
+#define sample_log_send()                       (FALSE)
+#define sample_log_ack(sequence)                ((void) 0)
+#endif
+
+# endif // _SAMPLE_LOG_H_
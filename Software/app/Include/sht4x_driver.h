@@ -15,6 +15,11 @@
 // **********************************************************************************************************
 //                                               Defines                                                    *
 // **********************************************************************************************************
+// Set to 1 to add the per-sensor calibration to the build, the datasheet conversion is used otherwise
+#ifndef SHT4X_CALIBRATION_ENABLED
+#define SHT4X_CALIBRATION_ENABLED               (0u)
+#endif
+
 // Structure forware declaration
 typedef struct sht4x_handle_s sht4x_handle_t;
 
@@ -49,6 +54,15 @@ typedef enum
     SHT4x_HEATER_DURATION_1_0SEC,
 } sht4x_heater_duration_e;
 
+// Two-point calibration of a sensor: calibrated value = gain . datasheet value + offset
+typedef struct
+{
+    uint16_t temperature_gain;                  // Q15, 32768 for a gain of 1 (0.5 to 1.5)
+    int16_t temperature_offset;                 // 0.01 degree Celsius
+    uint16_t humidity_gain;                     // Q15, 32768 for a gain of 1 (0.5 to 1.5)
+    int16_t humidity_offset;                    // 0.01 %RH
+} sht4x_calibration_t;
+
 // Send and receive function pointer types
 // **********************************************************************************************************
 // Function name    : sht4x_send_function                                                                   *
@@ -97,13 +111,29 @@ sht4x_handle_t* sht4x_init(sht4x_address_e i_address,
 
 // **********************************************************************************************************
 // Function name    : sht4x_get_serial_number                                                               *
-// Description      : Get the sensor serial number.                                                         *
+// Description      : Read the sensor serial number, and keep it in the handle.                             *
 // Argument         : (sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure                  *
 //                  : (uint32_t*) o_p_serial_number: Pointer to the serial number value                     *  
 // Return value     : (status_e) : Status of the operation                                                  *
 // **********************************************************************************************************
 status_e sht4x_get_serial_number(sht4x_handle_t* i_p_handle, uint32_t* o_p_serial_number);
 
+// **********************************************************************************************************
+// Function name    : sht4x_get_cached_serial_number                                                        *
+// Description      : Get the serial number read last by sht4x_get_serial_number, without bus transfer.     *
+// Argument         : (const sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure            *
+// Return value     : (uint32_t) : Serial number, 0 if it has not been read yet                             *
+// **********************************************************************************************************
+uint32_t sht4x_get_cached_serial_number(const sht4x_handle_t* i_p_handle);
+
+// **********************************************************************************************************
+// Function name    : sht4x_get_crc_errors                                                                  *
+// Description      : Get the number of measurement reads which failed their CRC, wraps around.             *
+// Argument         : (const sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure            *
+// Return value     : (uint16_t) : Number of CRC errors                                                     *
+// **********************************************************************************************************
+uint16_t sht4x_get_crc_errors(const sht4x_handle_t* i_p_handle);
+
 // **********************************************************************************************************
 // Function name    : sht4x_soft_reset                                                                      *
 // Description      : Perform a soft reset of the sensor.                                                   *
@@ -126,6 +156,91 @@ status_e sht4x_read_temperature_humidity(sht4x_handle_t* i_p_handle,
                                          int16_t* o_p_temperature, 
                                          uint16_t* o_p_humidity);
 
+// **********************************************************************************************************
+// Function name    : sht4x_start_measurement                                                               *
+// Description      : Send the measurement command without waiting for the conversion to complete.         *
+//                  : The result must be fetched with sht4x_read_measurement once the conversion time       *
+//                  : given by sht4x_get_measurement_time has elapsed.                                      *
+// Argument         : (sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure                  *
+//                  : (sht4x_precision_e) i_precision: Measurement precision                                *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+status_e sht4x_start_measurement(sht4x_handle_t* i_p_handle, sht4x_precision_e i_precision);
+
+// **********************************************************************************************************
+// Function name    : sht4x_read_measurement                                                                *
+// Description      : Read the result of a measurement started with sht4x_start_measurement.               *
+// Argument         : (sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure                  *
+//                  : (int16_t*) o_p_temperature: Pointer to the temperature value (in 0.1 degree Celsius)  *
+//                  : (uint16_t*) o_p_humidity: Pointer to the humidity value (in 0.1 %RH)                  *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+status_e sht4x_read_measurement(sht4x_handle_t* i_p_handle, int16_t* o_p_temperature, uint16_t* o_p_humidity);
+
+// **********************************************************************************************************
+// Function name    : sht4x_read_measurement_raw                                                            *
+// Description      : Read the raw words of a measurement started with sht4x_start_measurement, checked by  *
+//                    their CRC and not converted (passthrough to the station).                             *
+// Argument         : (sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure                  *
+//                  : (uint16_t*) o_p_raw_temperature: Pointer to the raw temperature word                  *
+//                  : (uint16_t*) o_p_raw_humidity: Pointer to the raw humidity word                        *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+status_e sht4x_read_measurement_raw(sht4x_handle_t* i_p_handle, uint16_t* o_p_raw_temperature,
+                                    uint16_t* o_p_raw_humidity);
+
+// **********************************************************************************************************
+// Function name    : sht4x_convert                                                                         *
+// Description      : Convert the raw words to 0.1 degree Celsius and 0.1 %RH (humidity cropped to 0-100%) *
+//                    with the calibration of the sensor.                                                   *
+// Argument         : (const sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure            *
+//                  : (uint16_t) i_raw_temperature: Raw temperature word                                    *
+//                  : (uint16_t) i_raw_humidity: Raw humidity word                                          *
+//                  : (int16_t*) o_p_temperature: Pointer to the temperature value (in 0.1 degree Celsius)  *
+//                  : (uint16_t*) o_p_humidity: Pointer to the humidity value (in 0.1 %RH)                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void sht4x_convert(const sht4x_handle_t* i_p_handle, uint16_t i_raw_temperature, uint16_t i_raw_humidity,
+                   int16_t* o_p_temperature, uint16_t* o_p_humidity);
+
+// **********************************************************************************************************
+// Function name    : sht4x_convert_high_resolution                                                         *
+// Description      : Convert the raw words to 0.01 degree Celsius and 0.01 %RH (humidity cropped to        *
+//                    0-100%) with the calibration of the sensor, rounded to the nearest (exact without     *
+//                    calibration).                                                                         *
+// Argument         : (const sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure            *
+//                  : (uint16_t) i_raw_temperature: Raw temperature word                                    *
+//                  : (uint16_t) i_raw_humidity: Raw humidity word                                          *
+//                  : (int16_t*) o_p_temperature: Pointer to the temperature value (in 0.01 degree Celsius) *
+//                  : (uint16_t*) o_p_humidity: Pointer to the humidity value (in 0.01 %RH)                 *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void sht4x_convert_high_resolution(const sht4x_handle_t* i_p_handle, uint16_t i_raw_temperature,
+                                   uint16_t i_raw_humidity, int16_t* o_p_temperature, uint16_t* o_p_humidity);
+
+#if SHT4X_CALIBRATION_ENABLED
+// **********************************************************************************************************
+// Function name    : sht4x_set_calibration                                                                 *
+// Description      : Fold a two-point calibration into the conversion constants of the sensor, the         *
+//                    conversions then cost no more than without calibration.                               *
+// Argument         : (sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure                  *
+//                  : (const sht4x_calibration_t*) i_p_calibration: Calibration of the sensor               *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void sht4x_set_calibration(sht4x_handle_t* i_p_handle, const sht4x_calibration_t* i_p_calibration);
+#else
+// Left out of the build
+#define sht4x_set_calibration(handle, calibration) ((void) (calibration))
+#endif
+
+// **********************************************************************************************************
+// Function name    : sht4x_get_measurement_time                                                            *
+// Description      : Get the conversion time of a measurement.                                             *
+// Argument         : (sht4x_precision_e) i_precision: Measurement precision                                *
+// Return value     : (uint32_t) : Conversion time in milliseconds                                          *
+// **********************************************************************************************************
+uint32_t sht4x_get_measurement_time(sht4x_precision_e i_precision);
+
 // **********************************************************************************************************   
 // Function name    : sht4x_read_temperature_humidity_heater                                                *
 // Description      : Read temperature and humidity from the sensor with heater enabled.                    *
@@ -142,4 +257,25 @@ status_e sht4x_read_temperature_humidity_heater(sht4x_handle_t* i_p_handle,
                                                 int16_t* o_p_temperature, 
                                                 uint16_t* o_p_humidity);
 
-# endif // _SHT4X_DRIVER_H_
\ No newline at end of file
+// **********************************************************************************************************
+// Function name    : sht4x_start_heater                                                                    *
+// Description      : Send the heater command without waiting for the end of the heating. The measurement   *
+//                    taken at the end of the heating is fetched with sht4x_read_measurement once the time  *
+//                    given by sht4x_get_heater_time has elapsed.                                           *
+// Argument         : (sht4x_handle_t*) i_p_handle: Pointer to the sensor handle structure                  *
+//                  : (sht4x_heater_power_e) i_heater_power: Heater power level                             *
+//                  : (sht4x_heater_duration_e) i_heater_duration: Heater duration                          *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+status_e sht4x_start_heater(sht4x_handle_t* i_p_handle, sht4x_heater_power_e i_heater_power,
+                            sht4x_heater_duration_e i_heater_duration);
+
+// **********************************************************************************************************
+// Function name    : sht4x_get_heater_time                                                                 *
+// Description      : Get the time from the heater command to the measurement result.                       *
+// Argument         : (sht4x_heater_duration_e) i_heater_duration: Heater duration                          *
+// Return value     : (uint32_t) : Time in milliseconds                                                     *
+// **********************************************************************************************************
+uint32_t sht4x_get_heater_time(sht4x_heater_duration_e i_heater_duration);
+
+# endif // _SHT4X_DRIVER_H_
@@ -0,0 +1,64 @@
+// **********************************************************************************************************
+// File name         : slot.h                                                                               *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Transmission slots: the cycles of the nodes sharing a station line are aligned on    *
+//                   : the station time, each node in its own slot                                          *
+// **********************************************************************************************************
+# ifndef _SLOT_H_
+# define _SLOT_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 1 to add the transmission slots to the build, the node sends at its own pace otherwise. The slots
+// are aligned on the station clock: CLOCK_SYNC_ENABLED must be set as well
+#ifndef SLOT_ENABLED
+#define SLOT_ENABLED                            (0u)
+#endif
+
+// Slot parameter value which derives the slot from the sensor serial number
+#define SLOT_FROM_SERIAL                        (0xFFu)
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if SLOT_ENABLED
+// **********************************************************************************************************
+// Function name    : slot_init                                                                             *
+// Description      : Keep the serial number used when no slot is assigned.                                 *
+// Argument         : (uint32_t) i_serial: Serial number of the sensor                                      *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void slot_init(uint32_t i_serial);
+
+// **********************************************************************************************************
+// Function name    : slot_is_enabled                                                                       *
+// Description      : Tell whether the transmissions are scheduled in slots: the node may only send from    *
+//                    the start of its cycle.                                                               *
+// Argument         : None                                                                                  *
+// Return value     : (bool_e) : TRUE if the slots are enabled                                              *
+// **********************************************************************************************************
+bool_e slot_is_enabled(void);
+
+// **********************************************************************************************************
+// Function name    : slot_align                                                                            *
+// Description      : Move the next wakeup to the start of the slot of the node, called at the start of the *
+//                    cycle. Nothing is done before the first synchronization of the clock.                 *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void slot_align(void);
+#else
+// Left out of the build
+#define slot_init(serial)                       ((void) 0)
+#define slot_is_enabled()                       (FALSE)
+#define slot_align()                            ((void) 0)
+#endif
+
+# endif // _SLOT_H_
@@ -0,0 +1,82 @@
+// **********************************************************************************************************
+// File name         : stats.h                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Running statistics (count, min, max, mean, standard deviation) over a window         *
+// **********************************************************************************************************
+# ifndef _STATS_H_
+# define _STATS_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the windowed statistics out of the build, every sample is then sent
+#ifndef STATS_ENABLED
+#define STATS_ENABLED                           (1u)
+#endif
+
+// Fractional bits of the running mean
+#define STATS_MEAN_SHIFT                        (8u)
+
+// Running statistics of one value (Welford), the mean and the sum of squared deviations are kept in
+// fixed point with enough fractional bits for the rounding of each update to stay below the output resolution
+typedef struct
+{
+    uint16_t count;
+    int16_t min;
+    int16_t max;
+    int32_t mean;                               // Mean in 1/256 of the value unit
+    uint64_t m2;                                // Sum of squared deviations in 1/65536 of the unit squared
+} stats_t;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if STATS_ENABLED
+// **********************************************************************************************************
+// Function name    : stats_reset                                                                           *
+// Description      : Start a new window.                                                                   *
+// Argument         : (stats_t*) o_p_stats: Statistics                                                      *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void stats_reset(stats_t* o_p_stats);
+
+// **********************************************************************************************************
+// Function name    : stats_add                                                                             *
+// Description      : Add a value to the window (saturates at 65535 values).                                *
+// Argument         : (stats_t*) io_p_stats: Statistics                                                     *
+//                  : (int16_t) i_value: Value                                                              *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void stats_add(stats_t* io_p_stats, int16_t i_value);
+
+// **********************************************************************************************************
+// Function name    : stats_mean                                                                            *
+// Description      : Mean of the window, with one more decimal than the values (e.g. 0.01 degree Celsius   *
+//                    for values in 0.1 degree Celsius).                                                    *
+// Argument         : (const stats_t*) i_p_stats: Statistics                                                *
+// Return value     : (int32_t) : Mean x 10, 0 if the window is empty                                       *
+// **********************************************************************************************************
+int32_t stats_mean(const stats_t* i_p_stats);
+
+// **********************************************************************************************************
+// Function name    : stats_stddev                                                                          *
+// Description      : Population standard deviation of the window, with one more decimal than the values.  *
+// Argument         : (const stats_t*) i_p_stats: Statistics                                                *
+// Return value     : (uint32_t) : Standard deviation x 10, 0 if the window is empty                        *
+// **********************************************************************************************************
+uint32_t stats_stddev(const stats_t* i_p_stats);
+#else
+// Left out of the build
+#define stats_reset(stats)                      ((void) 0)
+#define stats_add(stats, value)                 ((void) 0)
+#define stats_mean(stats)                       (0)
+#define stats_stddev(stats)                     (0u)
+#endif
+
+# endif // _STATS_H_
@@ -11,7 +11,43 @@
 //                                               Include                                                    *
 // **********************************************************************************************************
 #include "definitions.h"
-#include "main.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 1 to add the raw and high resolution formats to the build, the samples are sent in the standard
+// format otherwise
+#ifndef TASK_FORMATS_ENABLED
+#define TASK_FORMATS_ENABLED                    (0u)
+#endif
+
+// Set to 1 to add the periodic identity check to the build, the serials are then read again to detect a
+// replaced probe. The serials read at boot are kept otherwise
+#ifndef TASK_IDENTITY_ENABLED
+#define TASK_IDENTITY_ENABLED                   (0u)
+#endif
+
+// Format of the measurement frames
+typedef enum
+{
+    TASK_FORMAT_STANDARD = 0u,                  // 0.1 degree Celsius and 0.1 %RH, converted on the node
+    TASK_FORMAT_RAW,                            // Raw sensor words checked by CRC, converted by the station
+    TASK_FORMAT_HIGH_RESOLUTION,                // 0.01 degree Celsius and 0.01 %RH, converted on the node
+} task_format_e;
+
+// Frames sent on their own by the task, the energy simulator replays them (tools/energy_sim.c) so this header
+// is kept free of hardware dependencies
+// Message sizes: standard and high resolution (sample, attempts, derived values, identity, timestamp), raw
+// (words, attempts, identity, timestamp)
+#define TASK_MESSAGE_SIZE                       (16u)
+#define TASK_MESSAGE_RAW_SIZE                   (10u)
+
+// Heartbeat size: battery life, average current, consumed charge
+#define TASK_HEARTBEAT_SIZE                     (12u)
+
+// Number of cycles between two heartbeat frames, and of heartbeats between two diagnostic frames
+#define TASK_HEARTBEAT_PERIOD                   (12u)
+#define TASK_DIAG_PERIOD                        (10u)
 
 // **********************************************************************************************************
 //                                           Public fuctions                                                *
@@ -27,9 +63,27 @@ void task_init(void);
 // **********************************************************************************************************
 // Function name    : task                                                                                  *
 // Description      : Task executed to capture the temperature and humidity and send them                   *
+//                  : The cycle is pipelined: the result of a cycle is sent during the conversion of the    *
+//                  : next one, so a cycle is awake for the longest of both instead of their sum.           *
 // Argument         : None                                                                                  *
 // Return value     : Noe                                                                                   *
 // **********************************************************************************************************
 void task(void);
 
+// **********************************************************************************************************
+// Function name    : task_process_commands                                                                 *
+// Description      : Process the commands received from the station                                        *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void task_process_commands(void);
+
+// **********************************************************************************************************
+// Function name    : task_background                                                                       *
+// Description      : Background work done between the cycles (backlog streaming)                           *
+// Argument         : None                                                                                  *
+// Return value     : (bool_e) : TRUE if more work is pending and the MCU must not sleep                    *
+// **********************************************************************************************************
+bool_e task_background(void);
+
 # endif // _TASK_H_
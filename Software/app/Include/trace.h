@@ -0,0 +1,98 @@
+// **********************************************************************************************************
+// File name         : trace.h                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Binary event trace ring buffer, usable from interrupts and driver paths              *
+// **********************************************************************************************************
+# ifndef _TRACE_H_
+# define _TRACE_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "definitions.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Set to 0 to leave the trace out of the build
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED                           (1u)
+#endif
+
+// Number of records in the ring (power of 2)
+#define TRACE_SIZE                              (16u)
+
+// Traced events (keep in sync with tools/trace_decode.py)
+typedef enum
+{
+    TRACE_EVENT_TIM_IRQ = 0u,
+    TRACE_EVENT_SYSTICK,
+    TRACE_EVENT_TASK_START,
+    TRACE_EVENT_TASK_END,
+    TRACE_EVENT_I2C_SEND,
+    TRACE_EVENT_I2C_RECEIVE,
+    TRACE_EVENT_SHT4X_ERROR,
+    TRACE_EVENT_UART_TX,
+    TRACE_EVENT_COMMAND,
+    TRACE_EVENT_I2C_RECOVER,
+    TRACE_EVENT_HEATER,
+} trace_event_e;
+
+// Argument of the TRACE_EVENT_SHT4X_ERROR event
+typedef enum
+{
+    TRACE_SHT4X_ERROR_HANDLE = 0u,
+    TRACE_SHT4X_ERROR_SEND,
+    TRACE_SHT4X_ERROR_RECEIVE,
+    TRACE_SHT4X_ERROR_CRC,
+} trace_sht4x_error_e;
+
+// Events recorded by default, the SysTick is left out as it would flood the ring
+#define TRACE_DEFAULT_MASK                      (~(1u << TRACE_EVENT_SYSTICK))
+
+// Record an event, the mask is checked inline to keep the cost low in the interrupts
+#if TRACE_ENABLED
+#define TRACE_EVENT(event, arg)                 do                                                          \
+                                                {                                                           \
+                                                    if (ge_trace_mask & (1u << (event)))                    \
+                                                    {                                                       \
+                                                        trace_write((event), (uint8_t) (arg));              \
+                                                    }                                                       \
+                                                } while (0)
+#else
+#define TRACE_EVENT(event, arg)                 ((void) (arg))
+#endif
+
+// **********************************************************************************************************
+//                                           Public variables                                               *
+// **********************************************************************************************************
+// Mask of the recorded events (bit n records event n)
+extern volatile uint32_t ge_trace_mask;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if TRACE_ENABLED
+// **********************************************************************************************************
+// Function name    : trace_write                                                                           *
+// Description      : Write a record in the ring, the oldest record is overwritten when it is full.         *
+// Argument         : (trace_event_e) i_event: Event identifier                                             *
+//                  : (uint8_t) i_arg: Event argument                                                       *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void trace_write(trace_event_e i_event, uint8_t i_arg);
+
+// **********************************************************************************************************
+// Function name    : trace_dump                                                                            *
+// Description      : Send the records of the ring, oldest first, in a trace frame.                         *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void trace_dump(void);
+#else
+// Left out of the build, the mask is still accepted
+#define trace_dump()                            ((void) 0)
+#endif
+
+# endif // _TRACE_H_
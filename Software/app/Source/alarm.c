@@ -0,0 +1,226 @@
+// **********************************************************************************************************
+// File name         : alarm.c                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Threshold and rate-of-change alarms on the samples, with hysteresis                  *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "alarm.h"
+#include "config.h"
+#include "clock.h"
+
+#if ALARM_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Checked values
+#define ALARM_CHANNEL_TEMPERATURE               (0u)
+#define ALARM_CHANNEL_HUMIDITY                  (1u)
+#define ALARM_CHANNEL_COUNT                     (2u)
+
+// Flags of a channel, the humidity flags are the temperature ones shifted by the channel stride
+#define ALARM_FLAG_HIGH                         (ALARM_TEMPERATURE_HIGH)
+#define ALARM_FLAG_LOW                          (ALARM_TEMPERATURE_LOW)
+#define ALARM_FLAG_RATE                         (ALARM_TEMPERATURE_RATE)
+#define ALARM_CHANNEL_STRIDE                    (3u)
+#define ALARM_CHANNEL_MASK                      (0x07u)
+
+// Rate thresholds are given per minute
+#define ALARM_RATE_PERIOD_US                    (60000000u)
+#define ALARM_RATE_OFF                          (0xFFFFFFFFu)
+
+// Thresholds of a value, the rate is the largest change between two cycles in Q16
+typedef struct
+{
+    int32_t high;
+    int32_t low;
+    uint32_t rate;
+    int32_t previous;
+} alarm_channel_t;
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Thresholds and previous sample of each value
+static alarm_channel_t g_alarm_channels[ALARM_CHANNEL_COUNT];
+
+// Distance from a level threshold to clear its alarm
+static int32_t g_alarm_hysteresis;
+
+// Active alarms
+static uint8_t g_alarm_active;
+
+// The previous sample is valid, the rate can be computed
+static bool_e g_alarm_previous_valid = FALSE;
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : alarm_rate                                                                            *
+// Description      : Convert a rate threshold to the largest change between two cycles.                    *
+// Argument         : (uint32_t) i_rate: Rate threshold (0.1 unit per minute, 0 to disable)                 *
+// Return value     : (uint32_t) : Largest change between two cycles in Q16                                 *
+// **********************************************************************************************************
+static uint32_t alarm_rate(uint32_t i_rate);
+
+// **********************************************************************************************************
+// Function name    : alarm_check_channel                                                                   *
+// Description      : Check a value against its thresholds.                                                 *
+// Argument         : (alarm_channel_t*) io_p_channel: Thresholds and previous sample of the value          *
+//                  : (int32_t) i_value: Value                                                              *
+//                  : (uint8_t) i_active: Active flags of the value                                         *
+// Return value     : (uint8_t) : New active flags of the value                                             *
+// **********************************************************************************************************
+static uint8_t alarm_check_channel(alarm_channel_t* io_p_channel, int32_t i_value, uint8_t i_active);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : alarm_init                                                                            *
+// Description      : Load the thresholds from the parameters, called again when a parameter changes.       *
+// **********************************************************************************************************
+void alarm_init(void)
+{
+    // Level thresholds, stored as 16 bits two's complement
+    g_alarm_channels[ALARM_CHANNEL_TEMPERATURE].high = (int16_t) CONFIG_GET(CONFIG_KEY_ALARM_TEMPERATURE_HIGH);
+    g_alarm_channels[ALARM_CHANNEL_TEMPERATURE].low = (int16_t) CONFIG_GET(CONFIG_KEY_ALARM_TEMPERATURE_LOW);
+    g_alarm_channels[ALARM_CHANNEL_HUMIDITY].high = (int16_t) CONFIG_GET(CONFIG_KEY_ALARM_HUMIDITY_HIGH);
+    g_alarm_channels[ALARM_CHANNEL_HUMIDITY].low = (int16_t) CONFIG_GET(CONFIG_KEY_ALARM_HUMIDITY_LOW);
+    g_alarm_hysteresis = (int32_t) CONFIG_GET(CONFIG_KEY_ALARM_HYSTERESIS);
+
+    // Rate thresholds, converted once to the wakeup period so that the check needs no division
+    g_alarm_channels[ALARM_CHANNEL_TEMPERATURE].rate = alarm_rate(CONFIG_GET(CONFIG_KEY_ALARM_TEMPERATURE_RATE));
+    g_alarm_channels[ALARM_CHANNEL_HUMIDITY].rate = alarm_rate(CONFIG_GET(CONFIG_KEY_ALARM_HUMIDITY_RATE));
+}
+
+// **********************************************************************************************************
+// Function name    : alarm_check                                                                           *
+// Description      : Check a sample against the thresholds.                                                *
+// **********************************************************************************************************
+uint8_t alarm_check(int16_t i_temperature, uint16_t i_humidity)
+{
+    // Variable(s) declaration
+    uint8_t active;
+    uint8_t r_changed;
+
+    // Check both values
+    active = alarm_check_channel(&g_alarm_channels[ALARM_CHANNEL_TEMPERATURE], i_temperature,
+                                 g_alarm_active & ALARM_CHANNEL_MASK);
+    active |= (uint8_t) (alarm_check_channel(&g_alarm_channels[ALARM_CHANNEL_HUMIDITY], i_humidity,
+                                             (g_alarm_active >> ALARM_CHANNEL_STRIDE) & ALARM_CHANNEL_MASK) <<
+                         ALARM_CHANNEL_STRIDE);
+    g_alarm_previous_valid = TRUE;
+
+    // Keep the new state
+    r_changed = active ^ g_alarm_active;
+    g_alarm_active = active;
+
+    // Return the changed alarms
+    return r_changed;
+}
+
+// **********************************************************************************************************
+// Function name    : alarm_missed                                                                          *
+// Description      : Signal a cycle without sample, the next rate is not computed across the gap.          *
+// **********************************************************************************************************
+void alarm_missed(void)
+{
+    g_alarm_previous_valid = FALSE;
+}
+
+// **********************************************************************************************************
+// Function name    : alarm_get_active                                                                      *
+// Description      : Get the active alarms.                                                                *
+// **********************************************************************************************************
+uint8_t alarm_get_active(void)
+{
+    return g_alarm_active;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : alarm_rate                                                                            *
+// Description      : Convert a rate threshold to the largest change between two cycles.                    *
+// **********************************************************************************************************
+static uint32_t alarm_rate(uint32_t i_rate)
+{
+    // Variable(s) declaration
+    uint64_t r_rate;
+
+    // Disabled
+    if (i_rate == 0u)
+    {
+        return ALARM_RATE_OFF;
+    }
+
+    // Change per cycle in Q16: rate . period / 1 min, at least 1 so that a steady value never raises it
+    r_rate = clock_divide(((uint64_t) i_rate * ge_config_period_us) << 16, ALARM_RATE_PERIOD_US);
+    if (r_rate == 0u)
+    {
+        r_rate = 1u;
+    }
+    else if (r_rate >= ALARM_RATE_OFF)
+    {
+        r_rate = ALARM_RATE_OFF - 1u;
+    }
+
+    // Return the rate
+    return (uint32_t) r_rate;
+}
+
+// **********************************************************************************************************
+// Function name    : alarm_check_channel                                                                   *
+// Description      : Check a value against its thresholds.                                                 *
+// **********************************************************************************************************
+static uint8_t alarm_check_channel(alarm_channel_t* io_p_channel, int32_t i_value, uint8_t i_active)
+{
+    // Variable(s) declaration
+    uint32_t change;
+    uint8_t r_active;
+
+    // Variable(s) initialization
+    r_active = 0u;
+
+    // High level: raised above the threshold, cleared once back below it by the hysteresis
+    if ((i_value > io_p_channel->high) ||
+        (((i_active & ALARM_FLAG_HIGH) != 0u) && (i_value > (io_p_channel->high - g_alarm_hysteresis))))
+    {
+        r_active |= ALARM_FLAG_HIGH;
+    }
+
+    // Low level: same, mirrored
+    if ((i_value < io_p_channel->low) ||
+        (((i_active & ALARM_FLAG_LOW) != 0u) && (i_value < (io_p_channel->low + g_alarm_hysteresis))))
+    {
+        r_active |= ALARM_FLAG_LOW;
+    }
+
+    // Rate: raised above the threshold, cleared once the change falls to half of it. A single sample moves
+    // at most by the sensor span (1750) so the shift does not overflow
+    if (g_alarm_previous_valid == TRUE)
+    {
+        change = (uint32_t) ((i_value > io_p_channel->previous) ? (i_value - io_p_channel->previous) :
+                                                                   (io_p_channel->previous - i_value)) << 16;
+        if ((change > io_p_channel->rate) ||
+            (((i_active & ALARM_FLAG_RATE) != 0u) && (change > (io_p_channel->rate >> 1))))
+        {
+            r_active |= ALARM_FLAG_RATE;
+        }
+    }
+    else
+    {
+        // No previous sample: keep the rate alarm as is
+        r_active |= i_active & ALARM_FLAG_RATE;
+    }
+    io_p_channel->previous = i_value;
+
+    // Return the flags of the value
+    return r_active;
+}
+#endif
@@ -0,0 +1,269 @@
+// **********************************************************************************************************
+// File name         : clock.c                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Monotonic device clock, synchronized to the station clock with drift correction      *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "clock.h"
+#include "main.h"
+#include "com.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Time frame size: station time, error corrected and drift of the last synchronization
+#define CLOCK_FRAME_SIZE                        (12u)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Last synchronization: local and station time, the clock runs from there at the corrected rate
+static uint64_t g_clock_sync_local_us;
+static uint32_t g_clock_sync_station_ms;
+static bool_e g_clock_synced = FALSE;
+
+// Drift of the local clock from the station clock (ppm, positive when the local clock is slow)
+static int32_t g_clock_drift_ppm;
+
+#if CLOCK_SYNC_ENABLED
+// Error corrected by the last synchronization
+static int32_t g_clock_sync_error_ms;
+
+// Start of the drift measurement, and whether a drift was measured
+static uint64_t g_clock_drift_local_us;
+static uint32_t g_clock_drift_station_ms;
+static bool_e g_clock_drift_valid = FALSE;
+#endif
+
+// Last timestamp given, the timestamps never go back
+static uint32_t g_clock_last_ms;
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : clock_convert                                                                         *
+// Description      : Convert a local time to the station time.                                             *
+// Argument         : (uint64_t) i_local_us: Local time in microseconds                                     *
+// Return value     : (uint32_t) : Station time (ms), local time before the first synchronization           *
+// **********************************************************************************************************
+static uint32_t clock_convert(uint64_t i_local_us);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : clock_get_local_us                                                                    *
+// Description      : Get the local clock: wakeup timer periods and count since the timer start.            *
+// **********************************************************************************************************
+uint64_t clock_get_local_us(void)
+{
+    // Variable(s) declaration
+    uint32_t primask;
+    uint32_t periods;
+    uint32_t count;
+    int32_t shift;
+
+    // Read the periods and the count together
+    primask = __get_PRIMASK();
+    __disable_irq();
+    periods = ge_hw_tim_periods;
+    shift = ge_hw_tim_shift;
+    count = TIM->CNT;
+
+    // A period ended but its interrupt is not handled yet (masked, or called from an interrupt): count it,
+    // the count read again is the one after the update
+    if ((TIM->SR & TIM_SR_UIF) != 0u)
+    {
+        periods++;
+        count = TIM->CNT;
+    }
+    __set_PRIMASK(primask);
+
+    // Timer ticks to microseconds, the ticks moved by the phase changes of the timer are compensated
+    return clock_divide((uint64_t) (((int64_t) periods * (TIM->ARR + 1u)) + count + shift) * (TIM->PSC + 1u),
+                        HW_SYSCLK_MHZ);
+}
+
+// **********************************************************************************************************
+// Function name    : clock_get_ms                                                                          *
+// Description      : Get the timestamp of the records.                                                     *
+// **********************************************************************************************************
+uint32_t clock_get_ms(void)
+{
+    // Variable(s) declaration
+    uint32_t r_time;
+
+    // Hold the time after a backward correction
+    r_time = clock_convert(clock_get_local_us());
+    if ((int32_t) (r_time - g_clock_last_ms) < 0)
+    {
+        r_time = g_clock_last_ms;
+    }
+    g_clock_last_ms = r_time;
+
+    // Return the timestamp
+    return r_time;
+}
+
+#if CLOCK_SYNC_ENABLED
+// **********************************************************************************************************
+// Function name    : clock_sync                                                                            *
+// Description      : Align the clock to the station time and measure the drift.                            *
+// **********************************************************************************************************
+void clock_sync(uint32_t i_station_ms, uint64_t i_local_us)
+{
+    // Variable(s) declaration
+    uint64_t interval_us;
+    uint32_t interval_ms;
+    int32_t offset_ms;
+    int32_t drift_ppm;
+
+    // Error of the clock at the synchronization
+    g_clock_sync_error_ms = (int32_t) (i_station_ms - clock_convert(i_local_us));
+
+    // Drift: station time elapsed against local time elapsed, over a long enough interval
+    interval_us = i_local_us - g_clock_drift_local_us;
+    if ((g_clock_synced == TRUE) && (interval_us >= CLOCK_DRIFT_INTERVAL_US))
+    {
+        // In milliseconds the interval spans 49 days, the offset is computed on its magnitude
+        interval_ms = (uint32_t) clock_divide(interval_us, 1000u);
+        offset_ms = (int32_t) (i_station_ms - g_clock_drift_station_ms - interval_ms);
+        drift_ppm = (int32_t) clock_divide((uint64_t) ((offset_ms < 0) ? -offset_ms : offset_ms) * 1000000u,
+                                           interval_ms);
+        drift_ppm = (offset_ms < 0) ? -drift_ppm : drift_ppm;
+        if (drift_ppm > CLOCK_DRIFT_MAX_PPM)
+        {
+            drift_ppm = CLOCK_DRIFT_MAX_PPM;
+        }
+        else if (drift_ppm < -CLOCK_DRIFT_MAX_PPM)
+        {
+            drift_ppm = -CLOCK_DRIFT_MAX_PPM;
+        }
+
+        // The first measurement is taken as is, the next ones are averaged
+        if (g_clock_drift_valid == TRUE)
+        {
+            g_clock_drift_ppm += (drift_ppm - g_clock_drift_ppm) / (1 << CLOCK_DRIFT_SHIFT);
+        }
+        else
+        {
+            g_clock_drift_ppm = drift_ppm;
+            g_clock_drift_valid = TRUE;
+        }
+    }
+
+    // The drift is measured from the first synchronization, then from the last measurement
+    if ((g_clock_synced == FALSE) || (interval_us >= CLOCK_DRIFT_INTERVAL_US))
+    {
+        g_clock_drift_local_us = i_local_us;
+        g_clock_drift_station_ms = i_station_ms;
+    }
+
+    // Run from the station time
+    g_clock_sync_local_us = i_local_us;
+    g_clock_sync_station_ms = i_station_ms;
+    g_clock_synced = TRUE;
+}
+
+// **********************************************************************************************************
+// Function name    : clock_is_synced                                                                       *
+// Description      : Tell whether the clock runs on the station time.                                      *
+// **********************************************************************************************************
+bool_e clock_is_synced(void)
+{
+    return g_clock_synced;
+}
+
+// **********************************************************************************************************
+// Function name    : clock_to_local_us                                                                     *
+// Description      : Convert a station time interval to the local clock, with the drift correction.        *
+// **********************************************************************************************************
+uint32_t clock_to_local_us(uint32_t i_station_ms)
+{
+    return (uint32_t) clock_divide((uint64_t) i_station_ms * 1000000000u,
+                                   (uint32_t) (1000000 + g_clock_drift_ppm));
+}
+
+// **********************************************************************************************************
+// Function name    : clock_report                                                                          *
+// Description      : Send the last synchronization in a time frame.                                        *
+// **********************************************************************************************************
+void clock_report(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[CLOCK_FRAME_SIZE];
+    uint8_t* p_data;
+
+    // Station time, error corrected (0 before the first synchronization) and drift
+    p_data = com_put_u32(payload, g_clock_sync_station_ms);
+    p_data = com_put_u32(p_data, (uint32_t) g_clock_sync_error_ms);
+    com_put_u32(p_data, (uint32_t) g_clock_drift_ppm);
+
+    // Send the frame
+    com_send_frame(COM_FRAME_TIME, payload, sizeof(payload));
+}
+#endif
+
+// **********************************************************************************************************
+// Function name    : clock_divide                                                                          *
+// Description      : Divide a 64-bit value by a 32-bit one, one bit per step.                              *
+// **********************************************************************************************************
+uint64_t clock_divide(uint64_t i_dividend, uint32_t i_divisor)
+{
+    // Variable(s) declaration
+    uint32_t remainder;
+    uint32_t carry;
+    uint8_t step;
+
+    // Variable(s) initialization
+    remainder = 0u;
+
+    // The bits of the dividend move to the remainder as the bits of the quotient take their place
+    for (step = 0u; step < 64u; step++)
+    {
+        carry = remainder >> 31;
+        remainder = (remainder << 1) | (uint32_t) (i_dividend >> 63);
+        i_dividend <<= 1;
+        if ((carry != 0u) || (remainder >= i_divisor))
+        {
+            remainder -= i_divisor;
+            i_dividend |= 1u;
+        }
+    }
+
+    // Return the quotient
+    return i_dividend;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : clock_convert                                                                         *
+// Description      : Convert a local time to the station time.                                             *
+// **********************************************************************************************************
+static uint32_t clock_convert(uint64_t i_local_us)
+{
+    // Variable(s) declaration
+    uint32_t r_time;
+
+    if ((CLOCK_SYNC_ENABLED != 0u) && (g_clock_synced == TRUE))
+    {
+        // Time elapsed since the synchronization at the corrected rate
+        r_time = g_clock_sync_station_ms +
+                 (uint32_t) clock_divide((i_local_us - g_clock_sync_local_us) *
+                                         (uint64_t) (1000000 + g_clock_drift_ppm), 1000000000u);
+    }
+    else
+    {
+        // Local time
+        r_time = (uint32_t) clock_divide(i_local_us, 1000u);
+    }
+
+    // Return the time
+    return r_time;
+}
@@ -0,0 +1,341 @@
+// **********************************************************************************************************
+// File name         : com.c                                                                                *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Framed communication with the station over the communication UART                    *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "com.h"
+#include "main.h"
+#include "energy.h"
+#include "diag.h"
+#include "clock.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// CRC8 definition (same as the sensor)
+#define COM_CRC8_POLYNOMIAL                     (0x31u)
+#define COM_CRC8_INIT                           (0xFFu)
+
+// Transmit timeout: the time of the bytes at the current baudrate (a full frame takes more than 2 s at
+// 1200 bauds), plus a margin for the tick granularity and the interrupts
+#define COM_TX_MARGIN_MS                        (10u)
+#define COM_TX_TIMEOUT_MS(size)                 (((((uint32_t) (size)) * COM_BITS_PER_BYTE * 1000u) /         \
+                                                  ge_hw_uart_baudrate) + COM_TX_MARGIN_MS)
+
+// Command parser states
+typedef enum
+{
+    COM_RX_STATE_SOF = 0u,
+    COM_RX_STATE_TYPE,
+    COM_RX_STATE_SIZE,
+    COM_RX_STATE_PAYLOAD,
+    COM_RX_STATE_CRC,
+} com_rx_state_e;
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Command parser
+static com_rx_state_e g_rx_state = COM_RX_STATE_SOF;
+static com_command_t g_rx_command;
+static uint8_t g_rx_index;
+
+// Last complete command, handed over to the main loop
+static com_command_t g_command;
+static volatile bool_e g_command_ready = FALSE;
+
+#if COM_BAUDRATE_ENABLED
+// Baudrate before the last change and cycles left to confirm the new one, 0 once confirmed
+static uint32_t g_baudrate_previous;
+static volatile uint8_t g_baudrate_confirm;
+
+// Cycles without acknowledgment, the automatic detection runs once the fallback is reached
+static uint8_t g_link_down_cycles;
+#endif
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : com_send_frame                                                                        *
+// Description      : Send a frame to the station.                                                          *
+// **********************************************************************************************************
+status_e com_send_frame(com_frame_e i_type, const uint8_t* i_p_payload, uint8_t i_size)
+{
+    // Variable(s) declaration
+    status_e r_status;
+    uint8_t header[3];
+    uint8_t crc;
+
+    // Build the header and the CRC
+    header[0] = COM_FRAME_SOF;
+    header[1] = (uint8_t) i_type;
+    header[2] = i_size;
+    crc = com_crc8(COM_CRC8_INIT, &header[1], 2u);
+    crc = com_crc8(crc, i_p_payload, i_size);
+
+    // Account the transmit time in the energy estimate
+    energy_add(ENERGY_STATE_UART, ENERGY_FRAME_US(i_size, ge_hw_uart_baudrate));
+
+    // Send the header, the payload and the CRC
+    if ((STATUS_OK == hw_uart_transmit(header, 3u, COM_TX_TIMEOUT_MS(3u))) &&
+        (STATUS_OK == hw_uart_transmit(i_p_payload, i_size, COM_TX_TIMEOUT_MS(i_size))) &&
+        (STATUS_OK == hw_uart_transmit(&crc, 1u, COM_TX_TIMEOUT_MS(1u))))
+    {
+        // Success: update the status
+        r_status = STATUS_OK;
+    }
+    else
+    {
+        // Error: update the status and count it
+        r_status = STATUS_ERROR;
+        DIAG_COUNT(DIAG_COUNTER_UART_TX_ERRORS);
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : com_receive_byte                                                                      *
+// Description      : Feed a byte received from the station to the command parser (called from the ISR).    *
+// **********************************************************************************************************
+void com_receive_byte(uint8_t i_byte)
+{
+    // Run the parser state machine
+    switch (g_rx_state)
+    {
+        case COM_RX_STATE_SOF:
+            // Wait for the start of frame
+            if (i_byte == COM_FRAME_SOF)
+            {
+                g_rx_state = COM_RX_STATE_TYPE;
+            }
+            break;
+
+        case COM_RX_STATE_TYPE:
+            // Store the command type
+            g_rx_command.type = i_byte;
+            g_rx_state = COM_RX_STATE_SIZE;
+            break;
+
+        case COM_RX_STATE_SIZE:
+            // Store the payload size and drop oversized commands
+            g_rx_command.size = i_byte;
+            g_rx_index = 0u;
+            if (i_byte > COM_COMMAND_PAYLOAD_SIZE)
+            {
+                g_rx_state = COM_RX_STATE_SOF;
+            }
+            else if (i_byte == 0u)
+            {
+                g_rx_state = COM_RX_STATE_CRC;
+            }
+            else
+            {
+                g_rx_state = COM_RX_STATE_PAYLOAD;
+            }
+            break;
+
+        case COM_RX_STATE_PAYLOAD:
+            // Store the payload
+            g_rx_command.payload[g_rx_index++] = i_byte;
+            if (g_rx_index >= g_rx_command.size)
+            {
+                g_rx_state = COM_RX_STATE_CRC;
+            }
+            break;
+
+        case COM_RX_STATE_CRC:
+        default:
+            // Hand the command over if the CRC is valid and the previous one has been consumed
+            if ((g_command_ready == FALSE) &&
+                (i_byte == com_crc8(COM_CRC8_INIT, &g_rx_command.type, 2u + (size_t) g_rx_command.size)))
+            {
+                g_command = g_rx_command;
+                g_command.time_us = clock_get_local_us();
+                g_command_ready = TRUE;
+
+#if COM_BAUDRATE_ENABLED
+                // The station speaks the current baudrate
+                g_baudrate_confirm = 0u;
+#endif
+            }
+            g_rx_state = COM_RX_STATE_SOF;
+            break;
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : com_get_command                                                                       *
+// Description      : Get the last complete command received from the station.                              *
+// **********************************************************************************************************
+bool_e com_get_command(com_command_t* o_p_command)
+{
+    // Variable(s) declaration
+    bool_e r_result;
+
+    // Check if a command is available
+    if (g_command_ready == TRUE)
+    {
+        // Copy the command and release the slot for the parser
+        *o_p_command = g_command;
+        g_command_ready = FALSE;
+        r_result = TRUE;
+    }
+    else
+    {
+        // No command
+        r_result = FALSE;
+    }
+
+    // Return the result
+    return r_result;
+}
+
+#if COM_BAUDRATE_ENABLED
+// **********************************************************************************************************
+// Function name    : com_set_baudrate                                                                      *
+// Description      : Answer a baudrate request of the station, then switch to the new rate.                *
+// **********************************************************************************************************
+status_e com_set_baudrate(uint32_t i_baudrate)
+{
+    // Variable(s) declaration
+    uint8_t payload[4];
+    uint32_t previous;
+    status_e r_status;
+
+    // Variable(s) initialization
+    previous = ge_hw_uart_baudrate;
+
+    // Answer at the current rate with the rate used from now on, then switch once the answer is out (the
+    // transmission returns on its completion)
+    r_status = hw_uart_check_baudrate(i_baudrate);
+    com_put_u32(payload, (r_status == STATUS_OK) ? i_baudrate : previous);
+    com_send_frame(COM_FRAME_BAUDRATE, payload, sizeof(payload));
+    if ((r_status == STATUS_OK) && (i_baudrate != previous))
+    {
+        hw_uart_set_baudrate(i_baudrate);
+        g_baudrate_previous = previous;
+        g_baudrate_confirm = COM_BAUDRATE_CONFIRM_CYCLES;
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : com_tick                                                                              *
+// Description      : Supervise the baudrate once per cycle.                                                *
+// **********************************************************************************************************
+void com_tick(bool_e i_link_up)
+{
+    // The station did not follow the new rate: go back to the previous one
+    if ((g_baudrate_confirm != 0u) && (--g_baudrate_confirm == 0u))
+    {
+        hw_uart_set_baudrate(g_baudrate_previous);
+    }
+
+    // Link lost: the station may have restarted at its default rate, or at any rate if it starts its frames
+    // with the start of frame. Listen at the default rate and measure the next start of frame, again every
+    // cycle until a measurement is acknowledged
+    if (i_link_up == TRUE)
+    {
+        // Back after a fallback: keep the measured rate
+        if (g_link_down_cycles >= COM_BAUDRATE_FALLBACK_CYCLES)
+        {
+            hw_uart_autobaud_done();
+        }
+        g_link_down_cycles = 0u;
+    }
+    else if (g_link_down_cycles < COM_BAUDRATE_FALLBACK_CYCLES)
+    {
+        if (++g_link_down_cycles == COM_BAUDRATE_FALLBACK_CYCLES)
+        {
+            hw_uart_set_baudrate(COMMUNICATION_UART_BAUDRATE);
+            hw_uart_autobaud();
+        }
+    }
+    else
+    {
+        // Still down: the measurement may have caught noise, measure again
+        hw_uart_autobaud();
+    }
+}
+#endif
+
+// **********************************************************************************************************
+// Function name    : com_crc8                                                                              *
+// Description      : Compute the CRC8 of a buffer (polynomial 0x31, init 0xFF).                            *
+// **********************************************************************************************************
+uint8_t com_crc8(uint8_t i_crc, const uint8_t* i_p_data, size_t i_size)
+{
+    // Variable(s) declaration
+    size_t byte_index;
+    uint8_t bit_index;
+
+    // Process each byte
+    for (byte_index = 0u ; byte_index < i_size ; byte_index++)
+    {
+        i_crc ^= i_p_data[byte_index];
+
+        // Process each bit
+        for (bit_index = 0u ; bit_index < 8u ; bit_index++)
+        {
+            // Shift left and apply polynomial if needed
+            if (i_crc & 0x80u)
+            {
+                i_crc = (uint8_t) ((i_crc << 1u) ^ COM_CRC8_POLYNOMIAL);
+            }
+            else
+            {
+                i_crc <<= 1u;
+            }
+        }
+    }
+
+    // Return the CRC
+    return i_crc;
+}
+
+// **********************************************************************************************************
+// Function name    : com_put_u16                                                                           *
+// Description      : Write a 16 bits value in little endian in a payload.                                  *
+// **********************************************************************************************************
+uint8_t* com_put_u16(uint8_t* o_p_data, uint16_t i_value)
+{
+    // Write the bytes
+    o_p_data[0] = (uint8_t)  (i_value & 0x00FF);
+    o_p_data[1] = (uint8_t) ((i_value >> 8) & 0x00FF);
+
+    // Return the next position
+    return &o_p_data[2];
+}
+
+// **********************************************************************************************************
+// Function name    : com_put_u32                                                                           *
+// Description      : Write a 32 bits value in little endian in a payload.                                  *
+// **********************************************************************************************************
+uint8_t* com_put_u32(uint8_t* o_p_data, uint32_t i_value)
+{
+    // Write the two halves
+    o_p_data = com_put_u16(o_p_data, (uint16_t) (i_value & 0xFFFFu));
+    return com_put_u16(o_p_data, (uint16_t) (i_value >> 16));
+}
+
+// **********************************************************************************************************
+// Function name    : com_get_u32                                                                           *
+// Description      : Read a 32 bits value in little endian from a payload.                                 *
+// **********************************************************************************************************
+uint32_t com_get_u32(const uint8_t* i_p_data)
+{
+    // Assemble the four bytes
+    return ((uint32_t) i_p_data[0])         |
+           ((uint32_t) i_p_data[1] << 8u)  |
+           ((uint32_t) i_p_data[2] << 16u) |
+           ((uint32_t) i_p_data[3] << 24u);
+}
@@ -0,0 +1,501 @@
+// **********************************************************************************************************
+// File name         : config.c                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Runtime parameters kept in a log-structured flash store                              *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "config.h"
+#include "main.h"
+#include "com.h"
+#include "hw_flash.h"
+#include "sht4x_driver.h"
+#include "task.h"
+#include "alarm.h"
+#include "fusion.h"
+#include "slot.h"
+#include "clock.h"
+#include "energy.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Page header, programmed once all the records of a compacted page are written
+#define CONFIG_MAGIC                            (0x4346u)
+
+typedef struct
+{
+    uint16_t magic;
+    uint16_t generation;
+} config_header_t;
+
+// Record, the last valid record of a key holds its value
+#define CONFIG_RECORD_VERSION                   (1u)
+
+typedef struct
+{
+    uint8_t key;                                // 0xFF: erased record
+    uint8_t version;                            // Record format version
+    uint8_t reserved;
+    uint8_t crc;                                // CRC8 over key, version, reserved and value
+    uint32_t value;
+} config_record_t;
+
+// Page layout, the store uses the pages of its flash area in turn. With a single page the compaction erases
+// the active page: an interruption loses the stored parameters until they are set again
+#define CONFIG_PAGE_COUNT                       (((uint32_t) &_econfig - (uint32_t) &_sconfig) /              \
+                                                 FLASH_PAGE_SIZE)
+#define CONFIG_RECORDS_PER_PAGE                 ((FLASH_PAGE_SIZE - sizeof(config_header_t)) /                \
+                                                 sizeof(config_record_t))
+#define CONFIG_ERASED_KEY                       (0xFFu)
+
+// Range of a parameter
+typedef struct
+{
+    uint32_t min;
+    uint32_t max;
+} config_limit_t;
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Flash area reserved in the linker script
+extern uint8_t _sconfig;
+extern uint8_t _econfig;
+
+// RAM copy of the parameters, fully written by config_init
+NOINIT uint32_t ge_config[CONFIG_KEY_COUNT];
+uint32_t ge_config_period_us;
+
+// Default values, used when no record is stored
+static const uint32_t g_config_defaults[CONFIG_KEY_COUNT] =
+{
+    TIM_PRESCALER,                              // CONFIG_KEY_TIM_PRESCALER
+    TIM_PERIOD,                                 // CONFIG_KEY_TIM_PERIOD
+    SHT4x_PRECISION_HIGH,                       // CONFIG_KEY_PRECISION
+    SHT4x_A,                                    // CONFIG_KEY_SENSOR_ADDRESS
+    COMMUNICATION_UART_BAUDRATE,                // CONFIG_KEY_BAUDRATE
+    TEMP_HUM_SENSOR_TIMING_COMPUTED,            // CONFIG_KEY_I2C_TIMING
+    TASK_FORMAT_STANDARD,                       // CONFIG_KEY_FORMAT
+    0u,                                         // CONFIG_KEY_STATS_WINDOW
+    ALARM_LEVEL_HIGH_OFF,                       // CONFIG_KEY_ALARM_TEMPERATURE_HIGH
+    ALARM_LEVEL_LOW_OFF,                        // CONFIG_KEY_ALARM_TEMPERATURE_LOW
+    ALARM_LEVEL_HIGH_OFF,                       // CONFIG_KEY_ALARM_HUMIDITY_HIGH
+    ALARM_LEVEL_LOW_OFF,                        // CONFIG_KEY_ALARM_HUMIDITY_LOW
+    0u,                                         // CONFIG_KEY_ALARM_TEMPERATURE_RATE
+    0u,                                         // CONFIG_KEY_ALARM_HUMIDITY_RATE
+    5u,                                         // CONFIG_KEY_ALARM_HYSTERESIS
+    0u,                                         // CONFIG_KEY_FUSION_SENSORS
+    0u,                                         // CONFIG_KEY_CALIBRATION_SERIAL_0
+    CONFIG_CALIBRATION_NONE,                    // CONFIG_KEY_CALIBRATION_TEMPERATURE_0
+    CONFIG_CALIBRATION_NONE,                    // CONFIG_KEY_CALIBRATION_HUMIDITY_0
+    0u,                                         // CONFIG_KEY_CALIBRATION_SERIAL_1
+    CONFIG_CALIBRATION_NONE,                    // CONFIG_KEY_CALIBRATION_TEMPERATURE_1
+    CONFIG_CALIBRATION_NONE,                    // CONFIG_KEY_CALIBRATION_HUMIDITY_1
+    0u,                                         // CONFIG_KEY_CALIBRATION_SERIAL_2
+    CONFIG_CALIBRATION_NONE,                    // CONFIG_KEY_CALIBRATION_TEMPERATURE_2
+    CONFIG_CALIBRATION_NONE,                    // CONFIG_KEY_CALIBRATION_HUMIDITY_2
+    0u,                                         // CONFIG_KEY_TX_SLOT_COUNT
+    SLOT_FROM_SERIAL,                           // CONFIG_KEY_TX_SLOT
+    TEMP_HUM_SENSOR_SPEED_HZ,                   // CONFIG_KEY_I2C_SPEED
+    ENERGY_CURRENT_SLEEP_UA,                    // CONFIG_KEY_ENERGY_CURRENT_SLEEP
+    ENERGY_CURRENT_ACTIVE_UA,                   // CONFIG_KEY_ENERGY_CURRENT_ACTIVE
+    ENERGY_CURRENT_I2C_UA,                      // CONFIG_KEY_ENERGY_CURRENT_I2C
+    ENERGY_CURRENT_UART_UA,                     // CONFIG_KEY_ENERGY_CURRENT_UART
+    ENERGY_CURRENT_CONVERSION_UA,               // CONFIG_KEY_ENERGY_CURRENT_CONVERSION
+    ENERGY_CURRENT_HEATER_UA,                   // CONFIG_KEY_ENERGY_CURRENT_HEATER
+};
+
+// Accepted values
+static const config_limit_t g_config_limits[CONFIG_KEY_COUNT] =
+{
+    {0u, 0xFFFFu},                              // CONFIG_KEY_TIM_PRESCALER
+    {1u, 0xFFFFu},                              // CONFIG_KEY_TIM_PERIOD
+    {SHT4x_PRECISION_LOW, SHT4x_PRECISION_HIGH}, // CONFIG_KEY_PRECISION
+    {SHT4x_A, SHT4x_C},                         // CONFIG_KEY_SENSOR_ADDRESS
+    {COMMUNICATION_UART_BAUDRATE_MIN, COMMUNICATION_UART_BAUDRATE_MAX}, // CONFIG_KEY_BAUDRATE
+    {0u, 0xFFFFFFFFu},                          // CONFIG_KEY_I2C_TIMING
+    {TASK_FORMAT_STANDARD, TASK_FORMAT_HIGH_RESOLUTION}, // CONFIG_KEY_FORMAT
+    {0u, 0xFFFFu},                              // CONFIG_KEY_STATS_WINDOW
+    {0u, 0xFFFFu},                              // CONFIG_KEY_ALARM_TEMPERATURE_HIGH
+    {0u, 0xFFFFu},                              // CONFIG_KEY_ALARM_TEMPERATURE_LOW
+    {0u, 0xFFFFu},                              // CONFIG_KEY_ALARM_HUMIDITY_HIGH
+    {0u, 0xFFFFu},                              // CONFIG_KEY_ALARM_HUMIDITY_LOW
+    {0u, 0xFFFFu},                              // CONFIG_KEY_ALARM_TEMPERATURE_RATE
+    {0u, 0xFFFFu},                              // CONFIG_KEY_ALARM_HUMIDITY_RATE
+    {0u, 1000u},                                // CONFIG_KEY_ALARM_HYSTERESIS
+    {0u, (1u << FUSION_SENSOR_COUNT) - 1u},     // CONFIG_KEY_FUSION_SENSORS
+    {0u, 0xFFFFFFFFu},                          // CONFIG_KEY_CALIBRATION_SERIAL_0
+    {0x40000000u, 0xC000FFFFu},                 // CONFIG_KEY_CALIBRATION_TEMPERATURE_0
+    {0x40000000u, 0xC000FFFFu},                 // CONFIG_KEY_CALIBRATION_HUMIDITY_0
+    {0u, 0xFFFFFFFFu},                          // CONFIG_KEY_CALIBRATION_SERIAL_1
+    {0x40000000u, 0xC000FFFFu},                 // CONFIG_KEY_CALIBRATION_TEMPERATURE_1
+    {0x40000000u, 0xC000FFFFu},                 // CONFIG_KEY_CALIBRATION_HUMIDITY_1
+    {0u, 0xFFFFFFFFu},                          // CONFIG_KEY_CALIBRATION_SERIAL_2
+    {0x40000000u, 0xC000FFFFu},                 // CONFIG_KEY_CALIBRATION_TEMPERATURE_2
+    {0x40000000u, 0xC000FFFFu},                 // CONFIG_KEY_CALIBRATION_HUMIDITY_2
+    {0u, 0xFFu},                                // CONFIG_KEY_TX_SLOT_COUNT
+    {0u, 0xFFu},                                // CONFIG_KEY_TX_SLOT
+    {TEMP_HUM_SENSOR_SPEED_MIN_HZ, TEMP_HUM_SENSOR_SPEED_MAX_HZ}, // CONFIG_KEY_I2C_SPEED
+    {0u, ENERGY_CURRENT_MAX_UA},                // CONFIG_KEY_ENERGY_CURRENT_SLEEP
+    {0u, ENERGY_CURRENT_MAX_UA},                // CONFIG_KEY_ENERGY_CURRENT_ACTIVE
+    {0u, ENERGY_CURRENT_MAX_UA},                // CONFIG_KEY_ENERGY_CURRENT_I2C
+    {0u, ENERGY_CURRENT_MAX_UA},                // CONFIG_KEY_ENERGY_CURRENT_UART
+    {0u, ENERGY_CURRENT_MAX_UA},                // CONFIG_KEY_ENERGY_CURRENT_CONVERSION
+    {0u, ENERGY_CURRENT_MAX_UA},                // CONFIG_KEY_ENERGY_CURRENT_HEATER
+};
+
+// Active page, its generation and the next free record, kept with the RAM copy over a warm reset
+static NOINIT uint32_t g_page;
+static NOINIT uint16_t g_generation;
+static NOINIT uint32_t g_write_index;
+
+// Check of the RAM copy and of the store state
+static NOINIT uint16_t g_check;
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : config_load                                                                           *
+// Description      : Load the defaults then replay the records of the active page.                         *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void config_load(void);
+
+// **********************************************************************************************************
+// Function name    : config_ram_check                                                                      *
+// Description      : Compute the check of the RAM copy and of the store state.                             *
+// Argument         : None                                                                                  *
+// Return value     : (uint16_t) : Check value                                                              *
+// **********************************************************************************************************
+static uint16_t config_ram_check(void);
+
+// **********************************************************************************************************
+// Function name    : config_header                                                                         *
+// Description      : Get the header of a page.                                                             *
+// Argument         : (uint32_t) i_page: Page index                                                         *
+// Return value     : (const config_header_t*) : Pointer to the header in flash                             *
+// **********************************************************************************************************
+static const config_header_t* config_header(uint32_t i_page);
+
+// **********************************************************************************************************
+// Function name    : config_record                                                                         *
+// Description      : Get a record of a page.                                                               *
+// Argument         : (uint32_t) i_page: Page index                                                         *
+//                  : (uint32_t) i_index: Record index in the page                                          *
+// Return value     : (const config_record_t*) : Pointer to the record in flash                             *
+// **********************************************************************************************************
+static const config_record_t* config_record(uint32_t i_page, uint32_t i_index);
+
+// **********************************************************************************************************
+// Function name    : config_record_crc                                                                     *
+// Description      : Compute the CRC of a record.                                                          *
+// Argument         : (const config_record_t*) i_p_record: Pointer to the record                            *
+// Return value     : (uint8_t) : CRC value                                                                 *
+// **********************************************************************************************************
+static uint8_t config_record_crc(const config_record_t* i_p_record);
+
+// **********************************************************************************************************
+// Function name    : config_is_valid                                                                       *
+// Description      : Check a parameter value against its range.                                            *
+// Argument         : (uint32_t) i_key: Parameter key                                                       *
+//                  : (uint32_t) i_value: Parameter value                                                   *
+// Return value     : (bool_e) : TRUE if the key and the value are valid                                    *
+// **********************************************************************************************************
+static bool_e config_is_valid(uint32_t i_key, uint32_t i_value);
+
+// **********************************************************************************************************
+// Function name    : config_write_record                                                                   *
+// Description      : Program a record at the next free position of the active page.                        *
+// Argument         : (uint32_t) i_key: Parameter key                                                       *
+//                  : (uint32_t) i_value: Parameter value                                                   *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+static status_e config_write_record(uint32_t i_key, uint32_t i_value);
+
+// **********************************************************************************************************
+// Function name    : config_compact                                                                        *
+// Description      : Rewrite the parameters which differ from their default in the next page.              *
+// Argument         : None                                                                                  *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+static status_e config_compact(void);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : config_init                                                                           *
+// Description      : Load the defaults then the records stored in flash into the RAM copy, the copy is     *
+//                    kept as is after a watchdog or software reset.                                        *
+// **********************************************************************************************************
+void config_init(void)
+{
+    // After a watchdog or software reset the RAM copy is still valid: skip the replay of the records
+    if ((HW_RESET_IS_WARM() == FALSE) || (g_check != config_ram_check()))
+    {
+        config_load();
+        g_check = config_ram_check();
+    }
+
+    // Wakeup period used by the hot path
+    ge_config_period_us = (uint32_t) clock_divide((uint64_t) (ge_config[CONFIG_KEY_TIM_PRESCALER] + 1u) *
+                                                  (ge_config[CONFIG_KEY_TIM_PERIOD] + 1u), HW_SYSCLK_MHZ);
+}
+
+// **********************************************************************************************************
+// Function name    : config_set                                                                            *
+// Description      : Store a parameter, the hardware parameters take effect at the next reset.             *
+// **********************************************************************************************************
+status_e config_set(config_key_e i_key, uint32_t i_value)
+{
+    // Variable(s) declaration
+    status_e r_status;
+
+    // Check the parameter
+    if (config_is_valid(i_key, i_value) == FALSE)
+    {
+        return STATUS_ERROR;
+    }
+
+    // Nothing to write if the value does not change
+    if (ge_config[i_key] == i_value)
+    {
+        return STATUS_OK;
+    }
+
+    // Append a record, or rewrite the parameters in the next page when the active one is full
+    ge_config[i_key] = i_value;
+    if (g_write_index < CONFIG_RECORDS_PER_PAGE)
+    {
+        r_status = config_write_record(i_key, i_value);
+    }
+    else
+    {
+        r_status = config_compact();
+    }
+    g_check = config_ram_check();
+
+    // Return the status
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : config_report                                                                         *
+// Description      : Send the parameters to the station.                                                   *
+// **********************************************************************************************************
+void config_report(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[CONFIG_KEY_COUNT * sizeof(uint32_t)];
+    uint8_t* p_data;
+    uint32_t key;
+
+    // Variable(s) initialization
+    p_data = payload;
+
+    // One 32 bits value per key, in key order
+    for (key = 0u ; key < CONFIG_KEY_COUNT ; key++)
+    {
+        p_data = com_put_u32(p_data, ge_config[key]);
+    }
+
+    // Send the frame
+    com_send_frame(COM_FRAME_CONFIG, payload, sizeof(payload));
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : config_load                                                                           *
+// Description      : Load the defaults then replay the records of the active page.                         *
+// **********************************************************************************************************
+static void config_load(void)
+{
+    // Variable(s) declaration
+    const config_header_t* p_header;
+    const config_record_t* p_record;
+    uint32_t page;
+    uint32_t key;
+    bool_e found;
+
+    // Variable(s) initialization
+    found = FALSE;
+
+    // Start from the defaults
+    for (key = 0u ; key < CONFIG_KEY_COUNT ; key++)
+    {
+        ge_config[key] = g_config_defaults[key];
+    }
+
+    // The active page is the valid one with the highest generation
+    for (page = 0u ; page < CONFIG_PAGE_COUNT ; page++)
+    {
+        p_header = config_header(page);
+        if ((p_header->magic == CONFIG_MAGIC) &&
+            ((found == FALSE) || ((int16_t) (p_header->generation - g_generation) > 0)))
+        {
+            g_page = page;
+            g_generation = p_header->generation;
+            found = TRUE;
+        }
+    }
+
+    if (found == TRUE)
+    {
+        // Replay the records up to the first erased one, the last valid record of a key wins
+        for (g_write_index = 0u ; g_write_index < CONFIG_RECORDS_PER_PAGE ; g_write_index++)
+        {
+            p_record = config_record(g_page, g_write_index);
+            if (p_record->key == CONFIG_ERASED_KEY)
+            {
+                break;
+            }
+
+            // Records interrupted by a reset or written by another format are skipped
+            if ((p_record->version == CONFIG_RECORD_VERSION) && (p_record->crc == config_record_crc(p_record)) &&
+                (config_is_valid(p_record->key, p_record->value) == TRUE))
+            {
+                ge_config[p_record->key] = p_record->value;
+            }
+        }
+    }
+    else
+    {
+        // Empty store: the first write compacts into the first page
+        g_page = CONFIG_PAGE_COUNT - 1u;
+        g_generation = 0xFFFFu;
+        g_write_index = CONFIG_RECORDS_PER_PAGE;
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : config_ram_check                                                                      *
+// Description      : Compute the check of the RAM copy and of the store state.                             *
+// **********************************************************************************************************
+static uint16_t config_ram_check(void)
+{
+    // Variable(s) declaration
+    uint8_t crc;
+
+    // CRC over the parameters and the store state, tagged with the magic
+    crc = com_crc8(0xFFu, (const uint8_t*) ge_config, sizeof(ge_config));
+    crc = com_crc8(crc, (const uint8_t*) &g_page, sizeof(g_page));
+    crc = com_crc8(crc, (const uint8_t*) &g_generation, sizeof(g_generation));
+    crc = com_crc8(crc, (const uint8_t*) &g_write_index, sizeof(g_write_index));
+    return (uint16_t) ((CONFIG_MAGIC & 0xFF00u) | crc);
+}
+
+// **********************************************************************************************************
+// Function name    : config_header                                                                         *
+// Description      : Get the header of a page.                                                             *
+// **********************************************************************************************************
+static const config_header_t* config_header(uint32_t i_page)
+{
+    // Headers are at the start of the pages
+    return (const config_header_t*) (&_sconfig + (i_page * FLASH_PAGE_SIZE));
+}
+
+// **********************************************************************************************************
+// Function name    : config_record                                                                         *
+// Description      : Get a record of a page.                                                               *
+// **********************************************************************************************************
+static const config_record_t* config_record(uint32_t i_page, uint32_t i_index)
+{
+    // Records follow the header of their page
+    return (const config_record_t*) ((const uint8_t*) config_header(i_page) + sizeof(config_header_t) +
+                                     (i_index * sizeof(config_record_t)));
+}
+
+// **********************************************************************************************************
+// Function name    : config_record_crc                                                                     *
+// Description      : Compute the CRC of a record.                                                          *
+// **********************************************************************************************************
+static uint8_t config_record_crc(const config_record_t* i_p_record)
+{
+    // Variable(s) declaration
+    uint8_t crc;
+
+    // Key, version and reserved byte, then the value
+    crc = com_crc8(0xFFu, &i_p_record->key, 3u);
+    return com_crc8(crc, (const uint8_t*) &i_p_record->value, sizeof(i_p_record->value));
+}
+
+// **********************************************************************************************************
+// Function name    : config_is_valid                                                                       *
+// Description      : Check a parameter value against its range.                                            *
+// **********************************************************************************************************
+static bool_e config_is_valid(uint32_t i_key, uint32_t i_value)
+{
+    // Check the key then the range
+    if ((i_key < CONFIG_KEY_COUNT) && (i_value >= g_config_limits[i_key].min) &&
+        (i_value <= g_config_limits[i_key].max))
+    {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+// **********************************************************************************************************
+// Function name    : config_write_record                                                                   *
+// Description      : Program a record at the next free position of the active page.                        *
+// **********************************************************************************************************
+static status_e config_write_record(uint32_t i_key, uint32_t i_value)
+{
+    // Variable(s) declaration
+    config_record_t record;
+
+    // Build the record
+    record.key = (uint8_t) i_key;
+    record.version = CONFIG_RECORD_VERSION;
+    record.reserved = 0xFFu;
+    record.value = i_value;
+    record.crc = config_record_crc(&record);
+
+    // Program it, the slot is used even if programming fails
+    return hw_flash_program((uint32_t) config_record(g_page, g_write_index++), &record, sizeof(record));
+}
+
+// **********************************************************************************************************
+// Function name    : config_compact                                                                        *
+// Description      : Rewrite the parameters which differ from their default in the next page.              *
+// **********************************************************************************************************
+static status_e config_compact(void)
+{
+    // Variable(s) declaration
+    config_header_t header;
+    status_e r_status;
+    uint32_t key;
+
+    // Erase the next page, the active one itself with a single page
+    g_page = (g_page + 1u) % CONFIG_PAGE_COUNT;
+    g_generation++;
+    g_write_index = 0u;
+    r_status = hw_flash_erase_page((uint32_t) config_header(g_page));
+
+    // Write the parameters which differ from their default
+    for (key = 0u ; (key < CONFIG_KEY_COUNT) && (r_status == STATUS_OK) ; key++)
+    {
+        if (ge_config[key] != g_config_defaults[key])
+        {
+            r_status = config_write_record(key, ge_config[key]);
+        }
+    }
+
+    // The header is written last: an interrupted compaction leaves the previous page active, or no page and
+    // the defaults with a single page
+    if (r_status == STATUS_OK)
+    {
+        header.magic = CONFIG_MAGIC;
+        header.generation = g_generation;
+        r_status = hw_flash_program((uint32_t) config_header(g_page), &header, sizeof(header));
+    }
+
+    // Return the status
+    return r_status;
+}
@@ -0,0 +1,101 @@
+// **********************************************************************************************************
+// File name         : diag.c                                                                               *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Health and diagnostic counters, kept over the warm resets                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "diag.h"
+#include "main.h"
+#include "com.h"
+
+#if DIAG_ENABLED
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// The counters hold data from before the reset
+#define DIAG_MAGIC                              (0xD1A6C047u)
+
+// Time counters
+#define DIAG_TIME_FIRST                         (DIAG_COUNTER_ACTIVE_MS)
+#define DIAG_TIME_COUNT                         (DIAG_COUNTER_COUNT - DIAG_COUNTER_ACTIVE_MS)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Counters and their validity, in the .noinit section so that the startup code keeps them over the reset
+NOINIT uint32_t ge_diag_counters[DIAG_COUNTER_COUNT];
+static NOINIT uint32_t g_diag_magic;
+
+// Time below one millisecond not counted yet
+static uint16_t g_diag_remainders_us[DIAG_TIME_COUNT];
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : diag_init                                                                             *
+// Description      : Keep the counters over a watchdog or software reset, clear them otherwise.            *
+// **********************************************************************************************************
+void diag_init(void)
+{
+    // Variable(s) declaration
+    uint8_t counter;
+
+    // A power-on reset leaves random RAM
+    if ((HW_RESET_IS_WARM() == FALSE) || (g_diag_magic != DIAG_MAGIC))
+    {
+        for (counter = 0u; counter < DIAG_COUNTER_COUNT; counter++)
+        {
+            ge_diag_counters[counter] = 0u;
+        }
+        g_diag_magic = DIAG_MAGIC;
+    }
+
+    // Count the watchdog reset
+    if ((ge_hw_reset_cause & HW_RESET_IWDG) != 0u)
+    {
+        DIAG_COUNT(DIAG_COUNTER_WATCHDOG_RESETS);
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : diag_add_time                                                                         *
+// Description      : Add a duration to a time counter, the part below one millisecond is carried over.     *
+// **********************************************************************************************************
+void diag_add_time(diag_counter_e i_counter, uint32_t i_duration_us)
+{
+    // Variable(s) declaration
+    uint32_t duration_us;
+
+    // Whole milliseconds to the counter, the rest to the next call
+    duration_us = i_duration_us + g_diag_remainders_us[i_counter - DIAG_TIME_FIRST];
+    ge_diag_counters[i_counter] += duration_us / 1000u;
+    g_diag_remainders_us[i_counter - DIAG_TIME_FIRST] = (uint16_t) (duration_us % 1000u);
+}
+
+// **********************************************************************************************************
+// Function name    : diag_report                                                                           *
+// Description      : Send the counters in a diagnostic frame.                                              *
+// **********************************************************************************************************
+void diag_report(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[DIAG_REPORT_SIZE];
+    uint8_t* p_data;
+    uint8_t counter;
+
+    // Serialize the counters (little endian)
+    p_data = payload;
+    for (counter = 0u; counter < DIAG_COUNTER_COUNT; counter++)
+    {
+        p_data = com_put_u32(p_data, ge_diag_counters[counter]);
+    }
+
+    // Send the frame
+    com_send_frame(COM_FRAME_DIAG, payload, sizeof(payload));
+}
+#endif
@@ -0,0 +1,122 @@
+// **********************************************************************************************************
+// File name         : energy.c                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Energy-per-sample estimator and battery life model                                   *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "energy.h"
+#include "config.h"
+#include "clock.h"
+
+#if ENERGY_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Smoothing of the average current (exponential moving average over 2^N cycles)
+#define ENERGY_AVERAGE_SHIFT                    (3u)
+
+// Conversion factors
+#define ENERGY_US_PER_MS                        (1000u)
+#define ENERGY_MS_PER_H                         (3600000u)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Time spent in each contribution during the current cycle
+static uint32_t g_energy_times_us[ENERGY_STATE_COUNT];
+
+// Consumed charge since reset (in uA.ms) and smoothed average current
+static uint64_t g_energy_charge_uams;
+static uint32_t g_energy_average_ua;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : energy_add                                                                            *
+// Description      : Account time spent in a contribution during the current cycle.                        *
+// **********************************************************************************************************
+void energy_add(energy_state_e i_state, uint32_t i_duration_us)
+{
+    // Accumulate the time
+    g_energy_times_us[i_state] += i_duration_us;
+}
+
+// **********************************************************************************************************
+// Function name    : energy_cycle_end                                                                      *
+// Description      : Close the current cycle, the time not spent active is accounted as sleep.             *
+// **********************************************************************************************************
+void energy_cycle_end(uint32_t i_cycle_us)
+{
+    // Variable(s) declaration
+    uint64_t charge_uaus;
+    uint32_t average_ua;
+    uint8_t state;
+
+    // The MCU sleeps for the rest of the cycle
+    if (i_cycle_us > g_energy_times_us[ENERGY_STATE_ACTIVE])
+    {
+        g_energy_times_us[ENERGY_STATE_SLEEP] = i_cycle_us - g_energy_times_us[ENERGY_STATE_ACTIVE];
+    }
+    else
+    {
+        g_energy_times_us[ENERGY_STATE_SLEEP] = 0u;
+        i_cycle_us = g_energy_times_us[ENERGY_STATE_ACTIVE];
+    }
+
+    // Charge of the cycle, with the currents of the parameters
+    charge_uaus = 0u;
+    for (state = 0u ; state < ENERGY_STATE_COUNT ; state++)
+    {
+        charge_uaus += (uint64_t) CONFIG_GET(CONFIG_KEY_ENERGY_CURRENT_SLEEP + state) *
+                       g_energy_times_us[state];
+        g_energy_times_us[state] = 0u;
+    }
+    g_energy_charge_uams += clock_divide(charge_uaus, ENERGY_US_PER_MS);
+
+    // Average current of the cycle, smoothed over the last cycles
+    if (i_cycle_us != 0u)
+    {
+        average_ua = (uint32_t) clock_divide(charge_uaus, i_cycle_us);
+        if (g_energy_average_ua == 0u)
+        {
+            g_energy_average_ua = average_ua;
+        }
+        else
+        {
+            g_energy_average_ua = g_energy_average_ua - (g_energy_average_ua >> ENERGY_AVERAGE_SHIFT) + 
+                                  (average_ua >> ENERGY_AVERAGE_SHIFT);
+        }
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : energy_get_report                                                                     *
+// Description      : Get the consumed charge, the average current and the projected battery life.          *
+// **********************************************************************************************************
+void energy_get_report(energy_report_t* o_p_report)
+{
+    // Variable(s) declaration
+    uint32_t capacity_uah;
+
+    // Variable(s) initialization
+    capacity_uah = ENERGY_BATTERY_CAPACITY_MAH * 1000u;
+
+    // Consumed charge and average current
+    o_p_report->consumed_uah = (uint32_t) clock_divide(g_energy_charge_uams, ENERGY_MS_PER_H);
+    o_p_report->average_ua = g_energy_average_ua;
+
+    // Remaining battery life at the average current
+    if ((g_energy_average_ua != 0u) && (capacity_uah > o_p_report->consumed_uah))
+    {
+        o_p_report->battery_life_h = (capacity_uah - o_p_report->consumed_uah) / g_energy_average_ua;
+    }
+    else
+    {
+        o_p_report->battery_life_h = 0u;
+    }
+}
+#endif
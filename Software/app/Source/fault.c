@@ -0,0 +1,198 @@
+// **********************************************************************************************************
+// File name         : fault.c                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Fault capture in RAM kept over the reset, reported at the next boot                  *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "fault.h"
+#include "main.h"
+#include "com.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Record state: a fault waits to be reported, or the record only holds the count
+#define FAULT_MAGIC_PENDING                     (0xFA017EC7u)
+#define FAULT_MAGIC_REPORTED                    (0xFA0150FFu)
+
+// Fault record, in the .noinit section so that the startup code keeps it over the reset
+typedef struct
+{
+    uint32_t magic;
+    uint32_t pc;
+    uint32_t lr;
+    uint32_t psr;                               // xPSR, or additional information of a software fault
+    uint8_t reason;
+    uint8_t count;                              // Faults since the power-on reset
+    uint16_t check;                             // Complement of the folded XOR of the fields
+} fault_record_t;
+
+// Exception frame layout
+#define FAULT_FRAME_LR                          (5u)
+#define FAULT_FRAME_PC                          (6u)
+#define FAULT_FRAME_PSR                         (7u)
+
+// Crash frame size: reason, count, PC, LR, xPSR
+#define FAULT_FRAME_SIZE                        (14u)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+#if FAULT_ENABLED
+static NOINIT fault_record_t g_fault;
+#endif
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+#if FAULT_ENABLED
+// **********************************************************************************************************
+// Function name    : fault_check                                                                           *
+// Description      : Compute the check of the fault record.                                                *
+// Argument         : None                                                                                  *
+// Return value     : (uint16_t) : Check value                                                              *
+// **********************************************************************************************************
+static uint16_t fault_check(void);
+#endif
+
+// **********************************************************************************************************
+// Function name    : fault_save                                                                            *
+// Description      : Save a fault and reset.                                                               *
+// Argument         : (uint8_t) i_reason: Fault reason                                                      *
+//                  : (uint32_t) i_pc: Program counter                                                      *
+//                  : (uint32_t) i_lr: Link register                                                        *
+//                  : (uint32_t) i_psr: xPSR or additional information                                      *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void fault_save(uint8_t i_reason, uint32_t i_pc, uint32_t i_lr, uint32_t i_psr) __attribute__((noreturn));
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if FAULT_ENABLED
+// **********************************************************************************************************
+// Function name    : fault_init                                                                            *
+// Description      : Check the record kept over the reset, clear it after a power-on reset.                *
+// **********************************************************************************************************
+void fault_init(void)
+{
+    // A power-on reset leaves random RAM: the record is valid only with a known magic and a good check
+    if (((g_fault.magic != FAULT_MAGIC_PENDING) && (g_fault.magic != FAULT_MAGIC_REPORTED)) ||
+        (g_fault.check != fault_check()))
+    {
+        g_fault.magic = FAULT_MAGIC_REPORTED;
+        g_fault.count = 0u;
+        g_fault.check = fault_check();
+    }
+}
+#endif
+
+// **********************************************************************************************************
+// Function name    : fault_exception                                                                       *
+// Description      : Save the stacked PC, LR and xPSR of the faulting context, then reset.                 *
+// **********************************************************************************************************
+void fault_exception(const uint32_t* i_p_frame)
+{
+    // The active exception number is the reason
+    fault_save((uint8_t) (__get_IPSR() & 0x3Fu), i_p_frame[FAULT_FRAME_PC], i_p_frame[FAULT_FRAME_LR],
+               i_p_frame[FAULT_FRAME_PSR]);
+}
+
+// **********************************************************************************************************
+// Function name    : fault_software                                                                        *
+// Description      : Save a software fault with the address of its caller, then reset.                     *
+// **********************************************************************************************************
+void fault_software(fault_reason_e i_reason, uint32_t i_info)
+{
+    // The caller is the faulting point
+    fault_save((uint8_t) i_reason, (uint32_t) __builtin_return_address(0), 0u, i_info);
+}
+
+#if FAULT_ENABLED
+// **********************************************************************************************************
+// Function name    : fault_report                                                                          *
+// Description      : Send the crash frame if a fault was saved before the reset, then forget it.           *
+// **********************************************************************************************************
+void fault_report(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[FAULT_FRAME_SIZE];
+    uint8_t* p_data;
+
+    // Report the fault saved before the reset, if any
+    if (g_fault.magic == FAULT_MAGIC_PENDING)
+    {
+        payload[0] = g_fault.reason;
+        payload[1] = g_fault.count;
+        p_data = com_put_u32(&payload[2], g_fault.pc);
+        p_data = com_put_u32(p_data, g_fault.lr);
+        com_put_u32(p_data, g_fault.psr);
+        com_send_frame(COM_FRAME_CRASH, payload, sizeof(payload));
+
+        // Forget the fault, the count is kept until the next power-on reset
+        g_fault.magic = FAULT_MAGIC_REPORTED;
+        g_fault.check = fault_check();
+    }
+}
+#endif
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+#if FAULT_ENABLED
+// **********************************************************************************************************
+// Function name    : fault_check                                                                           *
+// Description      : Compute the check of the fault record.                                                *
+// **********************************************************************************************************
+static uint16_t fault_check(void)
+{
+    // Variable(s) declaration
+    uint32_t check;
+
+    // Fold the fields
+    check = g_fault.magic ^ g_fault.pc ^ g_fault.lr ^ g_fault.psr;
+    check ^= ((uint32_t) g_fault.reason << 8u) | g_fault.count;
+    return (uint16_t) ~((check >> 16u) ^ check);
+}
+#endif
+
+// **********************************************************************************************************
+// Function name    : fault_save                                                                            *
+// Description      : Save a fault and reset.                                                               *
+// **********************************************************************************************************
+static void fault_save(uint8_t i_reason, uint32_t i_pc, uint32_t i_lr, uint32_t i_psr)
+{
+#if FAULT_ENABLED
+    // Nothing may interrupt the capture
+    __disable_irq();
+
+    // Count every fault, saturated so that a reset loop does not bring the count back to 0
+    if (g_fault.count < UINT8_MAX)
+    {
+        g_fault.count++;
+    }
+
+    // Save the fault, unless the previous one was not reported yet (fault during the boot): the first one
+    // is kept
+    if (g_fault.magic != FAULT_MAGIC_PENDING)
+    {
+        g_fault.magic = FAULT_MAGIC_PENDING;
+        g_fault.pc = i_pc;
+        g_fault.lr = i_lr;
+        g_fault.psr = i_psr;
+        g_fault.reason = i_reason;
+    }
+    g_fault.check = fault_check();
+#else
+    (void) i_reason;
+    (void) i_pc;
+    (void) i_lr;
+    (void) i_psr;
+#endif
+
+    // Reset at once
+    NVIC_SystemReset();
+}
@@ -0,0 +1,142 @@
+// **********************************************************************************************************
+// File name         : fusion.c                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Fusion of redundant sensors: median vote, mean of the agreeing sensors and detection *
+//                   : of the sensor which disagrees                                                        *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "fusion.h"
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+#if FUSION_ENABLED
+// **********************************************************************************************************
+// Function name    : fusion_reference                                                                      *
+// Description      : Reference of the vote: median of three sensors, otherwise mean of the valid ones.     *
+// Argument         : (const int32_t*) i_p_values: Value of each sensor                                     *
+//                  : (uint8_t) i_valid: Valid sensors                                                      *
+// Return value     : (int32_t) : Reference                                                                 *
+// **********************************************************************************************************
+static int32_t fusion_reference(const int32_t* i_p_values, uint8_t i_valid);
+#endif
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+#if FUSION_ENABLED
+// **********************************************************************************************************
+// Function name    : fusion_vote                                                                           *
+// Description      : Vote between the valid sensors.                                                       *
+// **********************************************************************************************************
+uint8_t fusion_vote(const int32_t* i_p_temperature, const int32_t* i_p_humidity, uint8_t i_valid,
+                    uint8_t* o_p_used)
+{
+    // Variable(s) declaration
+    int32_t reference_temperature;
+    int32_t reference_humidity;
+    int32_t distance_temperature;
+    int32_t distance_humidity;
+    uint8_t sensor;
+    uint8_t r_outliers;
+
+    // Variable(s) initialization
+    reference_temperature = fusion_reference(i_p_temperature, i_valid);
+    reference_humidity = fusion_reference(i_p_humidity, i_valid);
+    r_outliers = 0u;
+
+    // The sensors too far from the reference disagree
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((i_valid & (1u << sensor)) != 0u)
+        {
+            distance_temperature = i_p_temperature[sensor] - reference_temperature;
+            distance_humidity = i_p_humidity[sensor] - reference_humidity;
+            if ((distance_temperature > FUSION_TEMPERATURE_TOLERANCE) ||
+                (distance_temperature < -FUSION_TEMPERATURE_TOLERANCE) ||
+                (distance_humidity > FUSION_HUMIDITY_TOLERANCE) ||
+                (distance_humidity < -FUSION_HUMIDITY_TOLERANCE))
+            {
+                r_outliers |= (uint8_t) (1u << sensor);
+            }
+        }
+    }
+
+    // Average the others. The median always agrees with itself, so only two sensors apart leave none: neither
+    // can be trusted more, keep both
+    *o_p_used = i_valid & (uint8_t) ~r_outliers;
+    if (*o_p_used == 0u)
+    {
+        *o_p_used = i_valid;
+    }
+
+    // Return the sensors which disagree
+    return r_outliers;
+}
+#endif
+
+// **********************************************************************************************************
+// Function name    : fusion_mean                                                                           *
+// Description      : Mean of the values of some sensors, rounded to the nearest.                           *
+// **********************************************************************************************************
+int32_t fusion_mean(const int32_t* i_p_values, uint8_t i_sensors)
+{
+    // Variable(s) declaration
+    int32_t sum;
+    uint32_t count;
+    uint32_t magnitude;
+    uint8_t sensor;
+
+    // Variable(s) initialization
+    sum = 0;
+    count = 0u;
+
+    // Sum the values
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((i_sensors & (1u << sensor)) != 0u)
+        {
+            sum += i_p_values[sensor];
+            count++;
+        }
+    }
+
+    // Mean of the magnitude, rounded half away from zero, without the signed division of the runtime
+    magnitude = (sum < 0) ? (0u - (uint32_t) sum) : (uint32_t) sum;
+    magnitude = (magnitude + (count >> 1)) / count;
+
+    // Return the mean with the sign of the sum
+    return (sum < 0) ? -(int32_t) magnitude : (int32_t) magnitude;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+#if FUSION_ENABLED
+// **********************************************************************************************************
+// Function name    : fusion_reference                                                                      *
+// Description      : Reference of the vote: median of three sensors, otherwise mean of the valid ones.     *
+// **********************************************************************************************************
+static int32_t fusion_reference(const int32_t* i_p_values, uint8_t i_valid)
+{
+    // Variable(s) declaration
+    int32_t low;
+    int32_t high;
+
+    // Fewer than three sensors: no majority, compare them to their mean
+    if (i_valid != ((1u << FUSION_SENSOR_COUNT) - 1u))
+    {
+        return fusion_mean(i_p_values, i_valid);
+    }
+
+    // The median is the third value clamped between the two others
+    low = (i_p_values[0] < i_p_values[1]) ? i_p_values[0] : i_p_values[1];
+    high = (i_p_values[0] < i_p_values[1]) ? i_p_values[1] : i_p_values[0];
+
+    // Return the median
+    return (i_p_values[2] < low) ? low : ((i_p_values[2] > high) ? high : i_p_values[2]);
+}
+#endif
@@ -0,0 +1,127 @@
+// **********************************************************************************************************
+// File name         : heater.c                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Heater manager: dries the sensor when the humidity stays high, within the heater     *
+//                   : duty cycle limit, and flags the samples distorted by the heating                     *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "heater.h"
+
+#if HEATER_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Number of escalation levels
+#define HEATER_LEVEL_COUNT                      (sizeof(g_heater_levels) / sizeof(g_heater_levels[0]))
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Pulses from the mildest to the strongest
+static const heater_pulse_t g_heater_levels[] =
+{
+    {SHT4x_HEATER_POWER_110, SHT4x_HEATER_DURATION_0_1SEC, 100000u},
+    {SHT4x_HEATER_POWER_200, SHT4x_HEATER_DURATION_0_1SEC, 100000u},
+    {SHT4x_HEATER_POWER_200, SHT4x_HEATER_DURATION_1_0SEC, 1000000u},
+};
+
+// Time elapsed in the current cycle, time spent above the humidity threshold and remaining settling time
+static uint32_t g_heater_elapsed_us;
+static uint32_t g_heater_high_us;
+static uint32_t g_heater_settle_us;
+
+// Heating time allowed by the duty cycle limit, full after the reset
+static uint32_t g_heater_budget_us = HEATER_BUDGET_MAX_US;
+
+// Level of the next pulse
+static uint8_t g_heater_level;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : heater_tick                                                                           *
+// Description      : Account the time elapsed since the previous cycle, called once per cycle.             *
+// **********************************************************************************************************
+void heater_tick(uint32_t i_elapsed_us)
+{
+    // Refill the budget: the heater may be on for 1/10 of the time
+    g_heater_elapsed_us = i_elapsed_us;
+    g_heater_budget_us += i_elapsed_us / HEATER_DUTY_DIVIDER;
+    if (g_heater_budget_us > HEATER_BUDGET_MAX_US)
+    {
+        g_heater_budget_us = HEATER_BUDGET_MAX_US;
+    }
+
+    // Count the settling time down
+    g_heater_settle_us = (g_heater_settle_us > i_elapsed_us) ? (g_heater_settle_us - i_elapsed_us) : 0u;
+}
+
+// **********************************************************************************************************
+// Function name    : heater_is_settling                                                                    *
+// Description      : Tell whether the sensor is still cooling down after a pulse.                          *
+// **********************************************************************************************************
+bool_e heater_is_settling(void)
+{
+    return (g_heater_settle_us != 0u) ? TRUE : FALSE;
+}
+
+// **********************************************************************************************************
+// Function name    : heater_request                                                                        *
+// Description      : Check a trusted sample and choose a pulse if the humidity has stayed high.            *
+// **********************************************************************************************************
+bool_e heater_request(uint16_t i_humidity, heater_pulse_t* o_p_pulse)
+{
+    // Variable(s) declaration
+    bool_e r_fire;
+
+    // Variable(s) initialization
+    r_fire = FALSE;
+
+    // Dry sensor: start again from the mildest pulse
+    if (i_humidity < HEATER_HUMIDITY_HIGH)
+    {
+        g_heater_high_us = 0u;
+        g_heater_level = 0u;
+    }
+    else
+    {
+        // Wet for long enough, fire when the duty cycle allows the pulse (otherwise wait for the budget)
+        if (g_heater_high_us < HEATER_TRIGGER_US)
+        {
+            g_heater_high_us += g_heater_elapsed_us;
+        }
+        if ((g_heater_high_us >= HEATER_TRIGGER_US) &&
+            (g_heater_budget_us >= g_heater_levels[g_heater_level].on_time_us))
+        {
+            *o_p_pulse = g_heater_levels[g_heater_level];
+            r_fire = TRUE;
+        }
+    }
+
+    // Return the decision
+    return r_fire;
+}
+
+// **********************************************************************************************************
+// Function name    : heater_fired                                                                          *
+// Description      : Account a fired pulse: duty cycle budget, settling time and escalation.               *
+// **********************************************************************************************************
+void heater_fired(const heater_pulse_t* i_p_pulse)
+{
+    // Spend the budget and wait for the sensor to cool down
+    g_heater_budget_us -= (i_p_pulse->on_time_us < g_heater_budget_us) ? i_p_pulse->on_time_us :
+                                                                          g_heater_budget_us;
+    g_heater_settle_us = HEATER_SETTLE_US;
+
+    // The next pulse needs the humidity to stay high for the trigger time again, and is stronger
+    g_heater_high_us = 0u;
+    if (g_heater_level < (HEATER_LEVEL_COUNT - 1u))
+    {
+        g_heater_level++;
+    }
+}
+#endif
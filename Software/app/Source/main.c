@@ -9,6 +9,9 @@
 // **********************************************************************************************************
 #include "main.h"
 #include "task.h"
+#include "config.h"
+#include "fault.h"
+#include "diag.h"
 
 // **********************************************************************************************************
 //                                               Defines                                                    *
@@ -17,6 +20,11 @@
 // **********************************************************************************************************
 //                                              Variables                                                   *
 // **********************************************************************************************************
+// Set by the timer interrupt when the task has to run
+volatile bool_e ge_task_request = FALSE;
+
+// Set by the timer interrupt at every period when the watchdog has to be refreshed
+volatile bool_e ge_wdg_request = FALSE;
 
 // **********************************************************************************************************
 //                                       Private prototype functions                                        *
@@ -30,29 +38,79 @@
 // **********************************************************************************************************
 int main(void)
 {
+    // Variable(s) declaration
+    bool_e busy;
+
+    // Variable(s) initialization
+    busy = FALSE;
+
     // Initialize the HAL library
     HAL_Init();
 
+    // Latch the reset cause and start the watchdog
+    hw_early_config();
+
+    // Check the fault record and the counters kept over the reset
+    fault_init();
+    diag_init();
+
+    // Load the runtime parameters, the hardware configuration uses them
+    config_init();
+
     // Configure the hardware
     hw_config();
 
+    // Report the crash saved before the reset now: the task may fault again before its first cycle ends
+    fault_report();
+
     // Initialize the task
     task_init();
 
     // Start the timer
-    HAL_TIM_Base_Start_IT(&ge_hw_tim_handle);
+    hw_tim_start();
+
+    // Take the first measurement right away instead of waiting for the first timer period
+    ge_task_request = TRUE;
 
     // Main loop
     while (1)
     {
+        // Refresh the watchdog on the timer wakeups only: the other wakeups (communication UART) could keep
+        // it quiet while the timer or the task is stuck
+        if (ge_wdg_request == TRUE)
+        {
+            ge_wdg_request = FALSE;
+            HW_WDG_REFRESH();
+        }
+
         // Disable SysTick
         HAL_SuspendTick();
 
-        // Sleep
-        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+        // Sleep unless the task has been requested meanwhile or background work is pending, a pending
+        // interrupt still wakes the core up
+        __disable_irq();
+        if ((ge_task_request == FALSE) && (busy == FALSE))
+        {
+            __WFI();
+            DIAG_COUNT(DIAG_COUNTER_WAKEUPS);
+        }
+        __enable_irq();
+
+        // Enable back SysTick, the wakeup may come from the communication UART
+        HAL_ResumeTick();
 
         // The timer has times out and we can now run the task
-        task();
+        if (ge_task_request == TRUE)
+        {
+            ge_task_request = FALSE;
+            task();
+        }
+
+        // Process the commands received from the station
+        task_process_commands();
+
+        // Do the background work
+        busy = task_background();
     }
 }
 
@@ -62,12 +120,8 @@ int main(void)
 // **********************************************************************************************************
 void error_handler(void)
 {
-    // Infinite loop
-    while (1)
-    {
-        // Break here for debugger
-        __asm("bkpt");
-    }
+    // Save the caller and reset, the fault is reported at the next boot
+    fault_software(FAULT_REASON_ERROR_HANDLER, 0u);
 }
 
 // **********************************************************************************************************
@@ -76,10 +130,6 @@ void error_handler(void)
 // **********************************************************************************************************
 void assert_failed(uint8_t* file, uint32_t line)
 {
-    // Infinite loop
-    while (1)
-    {
-        // Break here for debugger
-        __asm("bkpt");
-    }
+    // Save the caller and the line and reset, the fault is reported at the next boot
+    fault_software(FAULT_REASON_ASSERT, line);
 }
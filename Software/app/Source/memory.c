@@ -0,0 +1,92 @@
+// **********************************************************************************************************
+// File name         : memory.c                                                                             *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : RAM usage monitor (stack high-water mark, heap and static RAM usage)                 *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "memory.h"
+#include "com.h"
+
+#if MEMORY_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Number of 16 bits values in the memory frame
+#define MEMORY_REPORT_VALUES                    (6u)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Symbols defined in the linker script
+extern uint8_t _sdata;
+extern uint8_t _enoinit;
+extern uint8_t _end;
+extern uint8_t _estack;
+extern uint8_t _Min_Heap_Size;
+extern uint8_t _Min_Stack_Size;
+
+// Heap end, from the system memory allocator
+extern void* _sbrk(ptrdiff_t incr);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : memory_get_stack_peak                                                                 *
+// Description      : Get the deepest stack usage since reset, found from the unpainted stack reservation.  *
+// **********************************************************************************************************
+uint32_t memory_get_stack_peak(void)
+{
+    // Variable(s) declaration
+    const uint32_t* p_word;
+
+    // Look for the first word overwritten by the stack, starting from the bottom of its reservation
+    p_word = (const uint32_t*) ((uint32_t) &_estack - (uint32_t) &_Min_Stack_Size);
+    while ((p_word < (const uint32_t*) &_estack) && (*p_word == MEMORY_PAINT_PATTERN))
+    {
+        p_word++;
+    }
+
+    // Return the depth reached by the stack
+    return (uint32_t) &_estack - (uint32_t) p_word;
+}
+
+// **********************************************************************************************************
+// Function name    : memory_report                                                                         *
+// Description      : Send the RAM usage in a memory frame.                                                 *
+// **********************************************************************************************************
+void memory_report(void)
+{
+    // Variable(s) declaration
+    uint16_t values[MEMORY_REPORT_VALUES];
+    uint8_t payload[MEMORY_REPORT_VALUES * 2u];
+    uint8_t index;
+
+    // Stack peak and reservation
+    values[0] = (uint16_t) memory_get_stack_peak();
+    values[1] = (uint16_t) (uint32_t) &_Min_Stack_Size;
+
+    // Heap usage and reservation
+    values[2] = (uint16_t) ((uint32_t) _sbrk(0) - (uint32_t) &_end);
+    values[3] = (uint16_t) (uint32_t) &_Min_Heap_Size;
+
+    // Static RAM (.data, .bss and .noinit)
+    values[4] = (uint16_t) ((uint32_t) &_enoinit - (uint32_t) &_sdata);
+
+    // RAM left between the heap and the deepest stack usage
+    values[5] = (uint16_t) ((uint32_t) &_estack - (uint32_t) _sbrk(0) - values[0]);
+
+    // Serialize the values (little endian)
+    for (index = 0u ; index < MEMORY_REPORT_VALUES ; index++)
+    {
+        payload[2u * index]      = (uint8_t)  (values[index] & 0x00FF);
+        payload[2u * index + 1u] = (uint8_t) ((values[index] >> 8) & 0x00FF);
+    }
+
+    // Send the frame
+    com_send_frame(COM_FRAME_MEMORY, payload, sizeof(payload));
+}
+#endif
@@ -0,0 +1,110 @@
+// **********************************************************************************************************
+// File name         : prof.c                                                                               *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Per-phase timing instrumentation of the measurement cycle (DEBUG builds only)        *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "prof.h"
+#include "com.h"
+#include "main.h"
+
+#if PROF_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Statistics of a phase, durations in microseconds
+typedef struct
+{
+    uint16_t start;
+    uint16_t min;
+    uint16_t max;
+    uint16_t count;
+    uint32_t sum;
+} prof_entry_t;
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Statistics table
+static prof_entry_t g_prof_table[PROF_PHASE_COUNT];
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : prof_start                                                                            *
+// Description      : Timestamp the start of a phase.                                                       *
+// **********************************************************************************************************
+void prof_start(prof_phase_e i_phase)
+{
+    // Store the start timestamp
+    g_prof_table[i_phase].start = HW_TIMESTAMP_GET();
+}
+
+// **********************************************************************************************************
+// Function name    : prof_stop                                                                             *
+// Description      : Timestamp the end of a phase and update its min/max/mean.                             *
+// **********************************************************************************************************
+void prof_stop(prof_phase_e i_phase)
+{
+    // Variable(s) declaration
+    prof_entry_t* p_entry;
+    uint16_t duration;
+
+    // Variable(s) initialization
+    p_entry = &g_prof_table[i_phase];
+
+    // Compute the duration, the 16 bits subtraction handles the timer wrap
+    duration = (uint16_t) (HW_TIMESTAMP_GET() - p_entry->start);
+
+    // Update the statistics
+    if ((p_entry->count == 0u) || (duration < p_entry->min))
+    {
+        p_entry->min = duration;
+    }
+    if (duration > p_entry->max)
+    {
+        p_entry->max = duration;
+    }
+    if (p_entry->count < UINT16_MAX)
+    {
+        p_entry->count++;
+        p_entry->sum += duration;
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : prof_report                                                                           *
+// Description      : Send the min/max/mean of each phase (in microseconds) in a profile frame.             *
+// **********************************************************************************************************
+void prof_report(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[PROF_PHASE_COUNT * 6u];
+    uint8_t phase;
+    uint16_t mean;
+    uint8_t* p_data;
+
+    // Variable(s) initialization
+    p_data = payload;
+
+    // Serialize min, max and mean of each phase (little endian)
+    for (phase = 0u ; phase < PROF_PHASE_COUNT ; phase++)
+    {
+        mean = (g_prof_table[phase].count != 0u) ? 
+               (uint16_t) (g_prof_table[phase].sum / g_prof_table[phase].count) : 0u;
+        *p_data++ = (uint8_t)  (g_prof_table[phase].min & 0x00FF);
+        *p_data++ = (uint8_t) ((g_prof_table[phase].min >> 8) & 0x00FF);
+        *p_data++ = (uint8_t)  (g_prof_table[phase].max & 0x00FF);
+        *p_data++ = (uint8_t) ((g_prof_table[phase].max >> 8) & 0x00FF);
+        *p_data++ = (uint8_t)  (mean & 0x00FF);
+        *p_data++ = (uint8_t) ((mean >> 8) & 0x00FF);
+    }
+
+    // Send the frame
+    com_send_frame(COM_FRAME_PROFILE, payload, sizeof(payload));
+}
+#endif
@@ -0,0 +1,453 @@
+// **********************************************************************************************************
+// File name         : psychro.c                                                                            *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Derived psychrometric values with integer-only kernels                               *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "psychro.h"
+
+#if PSYCHRO_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Fixed-point format of the kernels (Q16)
+#define PSYCHRO_Q16_ONE                         (65536)
+
+// Table interpolation: 32 segments over [1, 2) in Q16
+#define PSYCHRO_TABLE_SHIFT                     (11u)
+#define PSYCHRO_TABLE_MASK                      ((1u << PSYCHRO_TABLE_SHIFT) - 1u)
+
+// Constants in Q16
+#define PSYCHRO_LN2_Q16                         (45426)
+#define PSYCHRO_LOG2E_Q16                       (94548)
+#define PSYCHRO_LOG2_1000_Q16                   (653118)
+#define PSYCHRO_MAGNUS_B_Q16                    (1154744)
+
+// Magnus c (0.01 degree Celsius), 0 degree Celsius (0.01 K) and 6.112 hPa x 2.1674 x 1000 (see below)
+#define PSYCHRO_MAGNUS_C                        (24312)
+#define PSYCHRO_ZERO_CELSIUS                    (27315)
+#define PSYCHRO_AH_FACTOR                       (13247u)
+
+// Rothfusz regression coefficients (degree Fahrenheit, %RH) grouped by power of the humidity:
+// HI = A(T) + B(T).RH + C(T).RH^2, each polynomial of T evaluated in the Horner form within 32 bits
+#define PSYCHRO_HI_A0                           (-2777350)      // Q16
+#define PSYCHRO_HI_A1                           (134284)        // Q16
+#define PSYCHRO_HI_A2                           (-7170)         // Q20
+#define PSYCHRO_HI_B0                           (170176860)     // Q24
+#define PSYCHRO_HI_B1                           (-235673)       // Q20
+#define PSYCHRO_HI_B2                           (20615)         // Q24
+#define PSYCHRO_HI_C0                           (-14714872)     // Q28
+#define PSYCHRO_HI_C1                           (3662834)       // Q32
+#define PSYCHRO_HI_C2                           (-17094)        // Q33
+
+// Degree Fahrenheit in Q8
+#define PSYCHRO_F(value)                        ((int32_t) ((value) * 256))
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// log2(1 + i / 32) in Q16
+static const int32_t g_psychro_log2_table[33] =
+{
+    0, 2909, 5732, 8473, 11136, 13727, 16248, 18704, 21098, 23433, 25711, 27936, 30109, 32234, 34312, 36346,
+    38336, 40286, 42196, 44068, 45904, 47705, 49472, 51207, 52911, 54584, 56229, 57845, 59434, 60997, 62534,
+    64047, 65536,
+};
+
+// 2^(i / 32) in Q16
+static const int32_t g_psychro_exp2_table[33] =
+{
+    65536, 66971, 68438, 69936, 71468, 73032, 74632, 76266, 77936, 79642, 81386, 83169, 84990, 86851, 88752,
+    90696, 92682, 94711, 96785, 98905, 101070, 103283, 105545, 107856, 110218, 112631, 115098, 117618, 120194,
+    122825, 125515, 128263, 131072,
+};
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : psychro_clamp                                                                         *
+// Description      : Clamp the inputs to the supported range.                                              *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+//                  : (int32_t*) o_p_temperature: Clamped temperature                                       *
+//                  : (int32_t*) o_p_humidity: Clamped humidity                                             *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void psychro_clamp(int16_t i_temperature, uint16_t i_humidity, int32_t* o_p_temperature,
+                          int32_t* o_p_humidity);
+
+// **********************************************************************************************************
+// Function name    : psychro_interpolate                                                                   *
+// Description      : Linear interpolation in a 33 entries table over [1, 2).                               *
+// Argument         : (const int32_t*) i_p_table: Table                                                     *
+//                  : (uint32_t) i_fraction: Position in [0, 1) in Q16                                      *
+// Return value     : (int32_t) : Interpolated value                                                        *
+// **********************************************************************************************************
+static int32_t psychro_interpolate(const int32_t* i_p_table, uint32_t i_fraction);
+
+// **********************************************************************************************************
+// Function name    : psychro_log2                                                                          *
+// Description      : Base 2 logarithm of a positive integer.                                               *
+// Argument         : (uint32_t) i_value: Value (not null)                                                  *
+// Return value     : (int32_t) : log2 of the value in Q16                                                  *
+// **********************************************************************************************************
+static int32_t psychro_log2(uint32_t i_value);
+
+// **********************************************************************************************************
+// Function name    : psychro_exp                                                                           *
+// Description      : Exponential of a Q16 value, computed as a power of 2.                                 *
+// Argument         : (int32_t) i_value: Exponent in Q16 (-10 to 10)                                        *
+// Return value     : (uint32_t) : Exponential in Q16                                                       *
+// **********************************************************************************************************
+static uint32_t psychro_exp(int32_t i_value);
+
+// **********************************************************************************************************
+// Function name    : psychro_magnus_exponent                                                               *
+// Description      : Exponent b.T / (c + T) of the Magnus formula.                                         *
+// Argument         : (int32_t) i_temperature: Clamped temperature (0.1 degree Celsius)                     *
+// Return value     : (int32_t) : Exponent in Q16                                                           *
+// **********************************************************************************************************
+static int32_t psychro_magnus_exponent(int32_t i_temperature);
+
+// **********************************************************************************************************
+// Function name    : psychro_sqrt                                                                          *
+// Description      : Integer square root.                                                                  *
+// Argument         : (uint32_t) i_value: Value                                                             *
+// Return value     : (uint32_t) : Square root rounded down                                                 *
+// **********************************************************************************************************
+static uint32_t psychro_sqrt(uint32_t i_value);
+
+// **********************************************************************************************************
+// Function name    : psychro_divide                                                                        *
+// Description      : Signed division rounded toward zero, done on the magnitude so that the signed         *
+//                    division of the runtime is not linked.                                                *
+// Argument         : (int32_t) i_numerator: Numerator                                                      *
+//                  : (int32_t) i_denominator: Denominator, positive                                        *
+// Return value     : (int32_t) : Quotient                                                                  *
+// **********************************************************************************************************
+static int32_t psychro_divide(int32_t i_numerator, int32_t i_denominator);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : psychro_dew_point                                                                     *
+// Description      : Dew point from the Magnus formula (b = 17.62, c = 243.12 degree Celsius).             *
+// **********************************************************************************************************
+int16_t psychro_dew_point(int16_t i_temperature, uint16_t i_humidity)
+{
+    // Variable(s) declaration
+    int32_t temperature;
+    int32_t humidity;
+    int32_t gamma;
+    int32_t numerator;
+    int32_t denominator;
+
+    // Clamp the inputs
+    psychro_clamp(i_temperature, i_humidity, &temperature, &humidity);
+
+    // gamma = ln(RH / 100 %) + b.T / (c + T), ln(x) = log2(x).ln(2)
+    gamma = (int32_t) (((int64_t) (psychro_log2((uint32_t) humidity) - PSYCHRO_LOG2_1000_Q16) * PSYCHRO_LN2_Q16) >>
+                       16);
+    gamma += psychro_magnus_exponent(temperature);
+
+    // Td = c.gamma / (b - gamma), in Q12 to stay within 32 bits, c in 0.01 degree Celsius
+    numerator = PSYCHRO_MAGNUS_C * (gamma >> 4);
+    denominator = ((PSYCHRO_MAGNUS_B_Q16 - gamma) >> 4) * 10;
+
+    // Round to the nearest 0.1 degree Celsius
+    if (numerator >= 0)
+    {
+        numerator += denominator / 2;
+    }
+    else
+    {
+        numerator -= denominator / 2;
+    }
+    return (int16_t) psychro_divide(numerator, denominator);
+}
+
+// **********************************************************************************************************
+// Function name    : psychro_absolute_humidity                                                             *
+// Description      : Absolute humidity from the Magnus saturation pressure and the ideal gas law.          *
+// **********************************************************************************************************
+uint16_t psychro_absolute_humidity(int16_t i_temperature, uint16_t i_humidity)
+{
+    // Variable(s) declaration
+    int32_t temperature;
+    int32_t humidity;
+    uint32_t inverse;
+    uint64_t value;
+
+    // Clamp the inputs
+    psychro_clamp(i_temperature, i_humidity, &temperature, &humidity);
+
+    // AH = 6.112 hPa . exp(b.T / (c + T)) . RH . 2.1674 / T(K) g/m3
+    // With RH in 0.1 %, T in 0.01 K and AH in 0.01 g/m3: AH = 13247.1 . exp(...) . RH / T
+    // The division by T is a multiplication by its inverse in Q31 to avoid a 64 bits division
+    inverse = 0x80000000u / (uint32_t) (PSYCHRO_ZERO_CELSIUS + (temperature * 10));
+    value = (uint64_t) psychro_exp(psychro_magnus_exponent(temperature)) * (uint32_t) humidity;
+    value = (value * inverse) >> 31;
+    value = (value * PSYCHRO_AH_FACTOR + (PSYCHRO_Q16_ONE / 2)) >> 16;
+
+    // Saturate to the output range
+    return (value > 0xFFFFu) ? 0xFFFFu : (uint16_t) value;
+}
+
+// **********************************************************************************************************
+// Function name    : psychro_heat_index                                                                    *
+// Description      : Heat index from the NWS algorithm (Steadman simple formula, Rothfusz regression and   *
+//                    its adjustments).                                                                     *
+// **********************************************************************************************************
+int16_t psychro_heat_index(int16_t i_temperature, uint16_t i_humidity)
+{
+    // Variable(s) declaration
+    int32_t temperature;
+    int32_t humidity;
+    int32_t t;
+    int32_t h;
+    int32_t index;
+    int32_t a;
+    int32_t b;
+    int32_t c;
+    int32_t distance;
+
+    // Clamp the inputs
+    psychro_clamp(i_temperature, i_humidity, &temperature, &humidity);
+
+    // Temperature in degree Fahrenheit and humidity in %, both in Q8
+    t = psychro_divide(temperature * 1152, 25) + PSYCHRO_F(32);
+    h = (int32_t) (((uint32_t) humidity * 128u) / 5u);
+
+    // Steadman simple formula: 0.5 (T + 61 + 1.2 (T - 68) + 0.094 RH)
+    index = (t + PSYCHRO_F(61) + psychro_divide((t - PSYCHRO_F(68)) * 6, 5) +
+             (int32_t) (((uint32_t) h * 47u) / 500u)) / 2;
+
+    // The regression is used when the average of the simple formula and the temperature reaches 80 F
+    if ((index + t) >= PSYCHRO_F(160))
+    {
+        // Polynomials of the temperature, the inner terms are shifted so that the products stay within 32 bits
+        a = PSYCHRO_HI_A1 + ((PSYCHRO_HI_A2 * t) >> 12);
+        a = PSYCHRO_HI_A0 + (((a >> 4) * t) >> 4);
+        b = PSYCHRO_HI_B1 + ((PSYCHRO_HI_B2 * t) >> 12);
+        b = PSYCHRO_HI_B0 + ((b >> 4) * t);
+        c = PSYCHRO_HI_C1 + ((PSYCHRO_HI_C2 * t) >> 9);
+        c = PSYCHRO_HI_C0 + (((c >> 7) * t) >> 5);
+
+        // Rothfusz regression: B + C.RH in Q24 then A + (B + C.RH).RH in Q16, back to Q8
+        b += ((c >> 10) * h) >> 2;
+        index = (a + (((b >> 13) * h) >> 3)) >> 8;
+
+        // Dry air: subtract (13 - RH) / 4 . sqrt((17 - |T - 95|) / 17)
+        if ((h < PSYCHRO_F(13)) && (t >= PSYCHRO_F(80)) && (t <= PSYCHRO_F(112)))
+        {
+            distance = (t > PSYCHRO_F(95)) ? (t - PSYCHRO_F(95)) : (PSYCHRO_F(95) - t);
+            index -= (int32_t) ((((uint32_t) (PSYCHRO_F(13) - h) / 4u) *
+                                 psychro_sqrt(((uint32_t) (PSYCHRO_F(17) - distance) * 256u) / 17u)) >> 8);
+        }
+
+        // Humid air: add (RH - 85) / 10 . (87 - T) / 5
+        if ((h > PSYCHRO_F(85)) && (t >= PSYCHRO_F(80)) && (t <= PSYCHRO_F(87)))
+        {
+            index += (int32_t) ((((uint32_t) (h - PSYCHRO_F(85)) / 10u) *
+                                 ((uint32_t) (PSYCHRO_F(87) - t) / 5u)) >> 8);
+        }
+    }
+
+    // Back to 0.1 degree Celsius, rounded to the nearest
+    index = (index - PSYCHRO_F(32)) * 25;
+    index += (index >= 0) ? 576 : -576;
+    return (int16_t) psychro_divide(index, 1152);
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : psychro_clamp                                                                         *
+// Description      : Clamp the inputs to the supported range.                                              *
+// **********************************************************************************************************
+static void psychro_clamp(int16_t i_temperature, uint16_t i_humidity, int32_t* o_p_temperature,
+                          int32_t* o_p_humidity)
+{
+    // Temperature
+    if (i_temperature < PSYCHRO_TEMPERATURE_MIN)
+    {
+        *o_p_temperature = PSYCHRO_TEMPERATURE_MIN;
+    }
+    else if (i_temperature > PSYCHRO_TEMPERATURE_MAX)
+    {
+        *o_p_temperature = PSYCHRO_TEMPERATURE_MAX;
+    }
+    else
+    {
+        *o_p_temperature = i_temperature;
+    }
+
+    // Humidity, 0 %RH is moved to the smallest step so that the logarithm stays defined
+    if (i_humidity < PSYCHRO_HUMIDITY_MIN)
+    {
+        *o_p_humidity = PSYCHRO_HUMIDITY_MIN;
+    }
+    else if (i_humidity > PSYCHRO_HUMIDITY_MAX)
+    {
+        *o_p_humidity = PSYCHRO_HUMIDITY_MAX;
+    }
+    else
+    {
+        *o_p_humidity = i_humidity;
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : psychro_interpolate                                                                   *
+// Description      : Linear interpolation in a 33 entries table over [1, 2).                               *
+// **********************************************************************************************************
+static int32_t psychro_interpolate(const int32_t* i_p_table, uint32_t i_fraction)
+{
+    // Variable(s) declaration
+    uint32_t index;
+    int32_t remainder;
+
+    // Segment and position in the segment
+    index = i_fraction >> PSYCHRO_TABLE_SHIFT;
+    remainder = (int32_t) (i_fraction & PSYCHRO_TABLE_MASK);
+
+    // Interpolate between the two ends of the segment
+    return i_p_table[index] + (((i_p_table[index + 1u] - i_p_table[index]) * remainder) >> PSYCHRO_TABLE_SHIFT);
+}
+
+// **********************************************************************************************************
+// Function name    : psychro_log2                                                                          *
+// Description      : Base 2 logarithm of a positive integer.                                               *
+// **********************************************************************************************************
+static int32_t psychro_log2(uint32_t i_value)
+{
+    // Variable(s) declaration
+    int32_t exponent;
+    uint32_t mantissa;
+
+    // Normalize the value to a mantissa in [1, 2) in Q16
+    exponent = 0;
+    mantissa = i_value;
+    while (mantissa >= (2u * PSYCHRO_Q16_ONE))
+    {
+        mantissa >>= 1;
+        exponent++;
+    }
+    while (mantissa < PSYCHRO_Q16_ONE)
+    {
+        mantissa <<= 1;
+        exponent--;
+    }
+
+    // log2(x) = e + log2(m), the mantissa being in Q16 the exponent is shifted by 16
+    return ((exponent + 16) * PSYCHRO_Q16_ONE) +
+           psychro_interpolate(g_psychro_log2_table, mantissa - PSYCHRO_Q16_ONE);
+}
+
+// **********************************************************************************************************
+// Function name    : psychro_exp                                                                           *
+// Description      : Exponential of a Q16 value, computed as a power of 2.                                 *
+// **********************************************************************************************************
+static uint32_t psychro_exp(int32_t i_value)
+{
+    // Variable(s) declaration
+    int32_t power;
+    int32_t integer;
+    uint32_t r_value;
+
+    // exp(x) = 2^(x.log2(e)), split in an integer power and a fraction in [0, 1)
+    power = (int32_t) (((int64_t) i_value * PSYCHRO_LOG2E_Q16) >> 16);
+    integer = power >> 16;
+    r_value = (uint32_t) psychro_interpolate(g_psychro_exp2_table, (uint32_t) power & 0xFFFFu);
+
+    // Apply the integer power
+    if (integer >= 0)
+    {
+        r_value <<= integer;
+    }
+    else
+    {
+        r_value >>= -integer;
+    }
+
+    // Return the value
+    return r_value;
+}
+
+// **********************************************************************************************************
+// Function name    : psychro_magnus_exponent                                                               *
+// Description      : Exponent b.T / (c + T) of the Magnus formula.                                         *
+// **********************************************************************************************************
+static int32_t psychro_magnus_exponent(int32_t i_temperature)
+{
+    // Variable(s) declaration
+    int32_t numerator;
+    int32_t denominator;
+    int32_t quotient;
+
+    // With T in 0.1 degree Celsius: b.T / (c + T) = 10.b.T / (10.c + 10.T), c in 0.01 degree Celsius
+    // The factor 10 is applied on the quotient and the remainder to stay within 32 bits
+    numerator = PSYCHRO_MAGNUS_B_Q16 * i_temperature;
+    denominator = PSYCHRO_MAGNUS_C + (i_temperature * 10);
+    quotient = psychro_divide(numerator, denominator);
+    return (quotient * 10) + psychro_divide((numerator - (quotient * denominator)) * 10, denominator);
+}
+
+// **********************************************************************************************************
+// Function name    : psychro_sqrt                                                                          *
+// Description      : Integer square root.                                                                  *
+// **********************************************************************************************************
+static uint32_t psychro_sqrt(uint32_t i_value)
+{
+    // Variable(s) declaration
+    uint32_t r_root;
+    uint32_t bit;
+
+    // Bit by bit, from the highest power of 4 below the value
+    r_root = 0u;
+    bit = 1u << 30;
+    while (bit > i_value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0u)
+    {
+        if (i_value >= (r_root + bit))
+        {
+            i_value -= r_root + bit;
+            r_root = (r_root >> 1) + bit;
+        }
+        else
+        {
+            r_root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    // Return the root
+    return r_root;
+}
+#endif
+
+// **********************************************************************************************************
+// Function name    : psychro_divide                                                                        *
+// Description      : Signed division rounded toward zero.                                                  *
+// **********************************************************************************************************
+static int32_t psychro_divide(int32_t i_numerator, int32_t i_denominator)
+{
+    // Variable(s) declaration
+    uint32_t quotient;
+
+    // Divide the magnitude
+    quotient = ((i_numerator < 0) ? (0u - (uint32_t) i_numerator) : (uint32_t) i_numerator) /
+               (uint32_t) i_denominator;
+
+    // Return the quotient with the sign of the numerator
+    return (i_numerator < 0) ? -(int32_t) quotient : (int32_t) quotient;
+}
@@ -0,0 +1,320 @@
+// **********************************************************************************************************
+// File name         : quality.c                                                                            *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Signal quality monitor of each sensor: stuck readings, impossible slew rates and CRC *
+//                   : error rate, checked in constant time per sample                                      *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "quality.h"
+#include "config.h"
+#include "fusion.h"
+
+#if QUALITY_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Slew rates are given per second
+#define QUALITY_SLEW_PERIOD_US                  (1000000u)
+
+// CRC error rate of a failed read (Q16)
+#define QUALITY_CRC_RATE_ONE                    (65536)
+
+// Saturated counters
+#define QUALITY_COUNTER_MAX                     (0xFFFFu)
+
+// State of a sensor
+typedef struct
+{
+    quality_counters_t counters;
+    int32_t crc_rate;                           // Averaged CRC error rate (Q16)
+    int32_t temperature;                        // Last accepted sample
+    int32_t humidity;
+    int32_t previous_temperature;               // Previous sample, accepted or not
+    int32_t previous_humidity;
+    uint16_t raw_temperature;                   // Previous raw words
+    uint16_t raw_humidity;
+    uint8_t repeats;                            // Samples with the same raw words as the previous one
+    uint8_t flags;
+    bool_e previous_valid;                      // The previous sample is from the previous cycle
+} quality_sensor_t;
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// State of each sensor, indexed by the sensor address
+static quality_sensor_t g_quality_sensors[FUSION_SENSOR_COUNT];
+
+// Largest change between two cycles (0.1 unit)
+static int32_t g_quality_temperature_slew;
+static int32_t g_quality_humidity_slew;
+
+// Sensors whose flags changed
+static uint8_t g_quality_changed;
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : quality_slew                                                                          *
+// Description      : Convert a slew rate to the largest change between two cycles.                         *
+// Argument         : (uint32_t) i_slew: Slew rate (0.1 unit per second)                                    *
+// Return value     : (int32_t) : Largest change between two cycles (0.1 unit)                              *
+// **********************************************************************************************************
+static int32_t quality_slew(uint32_t i_slew);
+
+// **********************************************************************************************************
+// Function name    : quality_is_jump                                                                       *
+// Description      : Tell whether a value moved further than the slew limit from a reference.              *
+// Argument         : (int32_t) i_value: Value                                                              *
+//                  : (int32_t) i_reference: Reference                                                      *
+//                  : (int32_t) i_slew: Largest change                                                      *
+// Return value     : (bool_e) : TRUE if the change is larger than the limit                                *
+// **********************************************************************************************************
+static bool_e quality_is_jump(int32_t i_value, int32_t i_reference, int32_t i_slew);
+
+// **********************************************************************************************************
+// Function name    : quality_count                                                                         *
+// Description      : Increment a saturated counter.                                                        *
+// Argument         : (uint16_t*) io_p_counter: Counter                                                     *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void quality_count(uint16_t* io_p_counter);
+
+// **********************************************************************************************************
+// Function name    : quality_set_flags                                                                     *
+// Description      : Update the flags of a sensor and remember the change.                                 *
+// Argument         : (uint8_t) i_sensor: Sensor address                                                    *
+//                  : (uint8_t) i_flags: New flags                                                          *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void quality_set_flags(uint8_t i_sensor, uint8_t i_flags);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : quality_init                                                                          *
+// Description      : Convert the slew limits to the wakeup period.                                         *
+// **********************************************************************************************************
+void quality_init(void)
+{
+    g_quality_temperature_slew = quality_slew(QUALITY_TEMPERATURE_SLEW);
+    g_quality_humidity_slew = quality_slew(QUALITY_HUMIDITY_SLEW);
+}
+
+// **********************************************************************************************************
+// Function name    : quality_read                                                                          *
+// Description      : Account a read of a sensor in its CRC error rate.                                     *
+// **********************************************************************************************************
+void quality_read(uint8_t i_sensor, bool_e i_crc_error)
+{
+    // Variable(s) declaration
+    quality_sensor_t* p_sensor;
+    uint8_t flags;
+
+    // Variable(s) initialization
+    p_sensor = &g_quality_sensors[i_sensor];
+    flags = p_sensor->flags;
+
+    // Exponential average of the failures, a single division-free update per read
+    if (i_crc_error == TRUE)
+    {
+        quality_count(&p_sensor->counters.crc_errors);
+        p_sensor->crc_rate += (QUALITY_CRC_RATE_ONE - p_sensor->crc_rate) >> QUALITY_CRC_SHIFT;
+    }
+    else
+    {
+        p_sensor->crc_rate -= p_sensor->crc_rate >> QUALITY_CRC_SHIFT;
+    }
+
+    // Raised above the high rate, cleared below the low one
+    if (p_sensor->crc_rate > (int32_t) QUALITY_CRC_RATE_HIGH)
+    {
+        flags |= QUALITY_CRC_RATE;
+    }
+    else if (p_sensor->crc_rate < (int32_t) QUALITY_CRC_RATE_LOW)
+    {
+        flags &= (uint8_t) ~QUALITY_CRC_RATE;
+    }
+    quality_set_flags(i_sensor, flags);
+}
+
+// **********************************************************************************************************
+// Function name    : quality_check                                                                         *
+// Description      : Check a sample of a sensor.                                                           *
+// **********************************************************************************************************
+bool_e quality_check(uint8_t i_sensor, uint16_t i_raw_temperature, uint16_t i_raw_humidity,
+                     int32_t i_temperature, int32_t i_humidity)
+{
+    // Variable(s) declaration
+    quality_sensor_t* p_sensor;
+    uint8_t flags;
+    bool_e r_accepted;
+
+    // Variable(s) initialization
+    p_sensor = &g_quality_sensors[i_sensor];
+    flags = p_sensor->flags & (uint8_t) ~(QUALITY_STUCK | QUALITY_SPIKE);
+    r_accepted = TRUE;
+
+    // Stuck: the same raw words sample after sample, the noise of a working sensor moves them
+    if ((i_raw_temperature == p_sensor->raw_temperature) && (i_raw_humidity == p_sensor->raw_humidity))
+    {
+        if (p_sensor->repeats < QUALITY_STUCK_SAMPLES)
+        {
+            p_sensor->repeats++;
+        }
+    }
+    else
+    {
+        p_sensor->repeats = 0u;
+    }
+    p_sensor->raw_temperature = i_raw_temperature;
+    p_sensor->raw_humidity = i_raw_humidity;
+    if (p_sensor->repeats >= QUALITY_STUCK_SAMPLES)
+    {
+        flags |= QUALITY_STUCK;
+        quality_count(&p_sensor->counters.stuck);
+        r_accepted = FALSE;
+    }
+
+    // Spike: too far from the last accepted sample and from the previous one, a single wrong sample is left
+    // out while a real step is followed from its second sample
+    else if ((p_sensor->previous_valid == TRUE) &&
+             (((quality_is_jump(i_temperature, p_sensor->temperature, g_quality_temperature_slew) == TRUE) &&
+               (quality_is_jump(i_temperature, p_sensor->previous_temperature,
+                                g_quality_temperature_slew) == TRUE)) ||
+              ((quality_is_jump(i_humidity, p_sensor->humidity, g_quality_humidity_slew) == TRUE) &&
+               (quality_is_jump(i_humidity, p_sensor->previous_humidity, g_quality_humidity_slew) == TRUE))))
+    {
+        flags |= QUALITY_SPIKE;
+        quality_count(&p_sensor->counters.spikes);
+        r_accepted = FALSE;
+    }
+    else
+    {
+        p_sensor->temperature = i_temperature;
+        p_sensor->humidity = i_humidity;
+    }
+
+    // The sample is the reference of the next one, unless it is stuck
+    if (r_accepted == TRUE)
+    {
+        p_sensor->previous_valid = TRUE;
+    }
+    p_sensor->previous_temperature = i_temperature;
+    p_sensor->previous_humidity = i_humidity;
+    quality_set_flags(i_sensor, flags);
+
+    // Return the verdict
+    return r_accepted;
+}
+
+// **********************************************************************************************************
+// Function name    : quality_missed                                                                        *
+// Description      : Signal a cycle without sample of a sensor.                                            *
+// **********************************************************************************************************
+void quality_missed(uint8_t i_sensor)
+{
+    g_quality_sensors[i_sensor].previous_valid = FALSE;
+}
+
+// **********************************************************************************************************
+// Function name    : quality_get_changed                                                                   *
+// Description      : Get the sensors whose flags changed since the last call.                              *
+// **********************************************************************************************************
+uint8_t quality_get_changed(void)
+{
+    // Variable(s) declaration
+    uint8_t r_changed;
+
+    // Read and clear
+    r_changed = g_quality_changed;
+    g_quality_changed = 0u;
+
+    // Return the sensors
+    return r_changed;
+}
+
+// **********************************************************************************************************
+// Function name    : quality_get_flags                                                                     *
+// Description      : Get the quality flags of a sensor.                                                    *
+// **********************************************************************************************************
+uint8_t quality_get_flags(uint8_t i_sensor)
+{
+    return g_quality_sensors[i_sensor].flags;
+}
+
+// **********************************************************************************************************
+// Function name    : quality_get_counters                                                                  *
+// Description      : Get the counters of a sensor.                                                         *
+// **********************************************************************************************************
+const quality_counters_t* quality_get_counters(uint8_t i_sensor)
+{
+    return &g_quality_sensors[i_sensor].counters;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : quality_slew                                                                          *
+// Description      : Convert a slew rate to the largest change between two cycles.                         *
+// **********************************************************************************************************
+static int32_t quality_slew(uint32_t i_slew)
+{
+    // Variable(s) declaration
+    uint64_t r_slew;
+
+    // Change per cycle: slew . period / 1 s, at least one second worth so that a short period keeps a margin
+    // over the noise, at most the sensor span
+    r_slew = ((uint64_t) i_slew * ge_config_period_us) / QUALITY_SLEW_PERIOD_US;
+    if (r_slew < i_slew)
+    {
+        r_slew = i_slew;
+    }
+    else if (r_slew > INT16_MAX)
+    {
+        r_slew = INT16_MAX;
+    }
+
+    // Return the change
+    return (int32_t) r_slew;
+}
+
+// **********************************************************************************************************
+// Function name    : quality_is_jump                                                                       *
+// Description      : Tell whether a value moved further than the slew limit from a reference.              *
+// **********************************************************************************************************
+static bool_e quality_is_jump(int32_t i_value, int32_t i_reference, int32_t i_slew)
+{
+    return (((i_value - i_reference) > i_slew) || ((i_reference - i_value) > i_slew)) ? TRUE : FALSE;
+}
+
+// **********************************************************************************************************
+// Function name    : quality_count                                                                         *
+// Description      : Increment a saturated counter.                                                        *
+// **********************************************************************************************************
+static void quality_count(uint16_t* io_p_counter)
+{
+    if (*io_p_counter < QUALITY_COUNTER_MAX)
+    {
+        (*io_p_counter)++;
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : quality_set_flags                                                                     *
+// Description      : Update the flags of a sensor and remember the change.                                 *
+// **********************************************************************************************************
+static void quality_set_flags(uint8_t i_sensor, uint8_t i_flags)
+{
+    if (i_flags != g_quality_sensors[i_sensor].flags)
+    {
+        g_quality_changed |= (uint8_t) (1u << i_sensor);
+        g_quality_sensors[i_sensor].flags = i_flags;
+    }
+}
+#endif
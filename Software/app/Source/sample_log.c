@@ -0,0 +1,497 @@
+// **********************************************************************************************************
+// File name         : sample_log.c                                                                         *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Flash-backed circular log of the samples the station did not acknowledge             *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "sample_log.h"
+#include "com.h"
+#include "hw_flash.h"
+#include <string.h>
+
+#if SAMPLE_LOG_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Page header, programmed with the first block of the page (the magic changes with the block layout)
+#define SAMPLE_LOG_MAGIC                        (0x4C48u)
+
+typedef struct
+{
+    uint16_t magic;
+    uint16_t sequence;
+} sample_log_header_t;
+
+// Page layout
+#define SAMPLE_LOG_BLOCK_SIZE                   (sizeof(sample_log_block_t))
+#define SAMPLE_LOG_BLOCKS_PER_PAGE              ((FLASH_PAGE_SIZE - sizeof(sample_log_header_t)) /             \
+                                                 SAMPLE_LOG_BLOCK_SIZE)
+#define SAMPLE_LOG_MAX_SAMPLES                  (SAMPLE_LOG_BLOCK_DELTAS + 1u)
+
+// A sample further than 1/2^n of the interval from its expected time starts a new block
+#define SAMPLE_LOG_JITTER_SHIFT                 (2u)
+
+// Blocks closed and waiting for the flush: one per cycle, and one more behind a page erase
+#define SAMPLE_LOG_QUEUE_DEPTH                  (2u)
+
+// Flash state values
+#define SAMPLE_LOG_ERASED_COUNT                 (0xFFu)
+#define SAMPLE_LOG_STATE_SENT                   (0x0000u)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Flash area reserved in the linker script
+extern uint8_t _slog;
+extern uint8_t _elog;
+
+// Geometry, blocks are indexed linearly over the whole area
+static uint32_t g_page_count;
+static uint32_t g_block_count;
+
+// Write position, read position (oldest block not acknowledged), first block acknowledged but not marked in
+// flash yet and sequence number of the write page
+static uint32_t g_write_index;
+static uint32_t g_read_index;
+static uint32_t g_mark_index;
+static uint16_t g_sequence;
+static bool_e g_erase_pending = FALSE;
+
+// The block at the read position was sent and waits for the acknowledgment of the station, which echoes the
+// sequence number of the frame
+static bool_e g_sending = FALSE;
+static uint8_t g_frame_sequence = 0u;
+
+// Block being filled (valid according to its count) and blocks closed but not programmed yet, oldest first
+static NOINIT sample_log_block_t g_block;
+static NOINIT sample_log_block_t g_queue[SAMPLE_LOG_QUEUE_DEPTH];
+static uint8_t g_queue_count = 0u;
+
+// Last sample appended, reference of the next delta
+static int16_t g_last_temperature;
+static uint16_t g_last_humidity;
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : sample_log_header                                                                     *
+// Description      : Get the header of a page.                                                             *
+// Argument         : (uint32_t) i_page: Page index                                                         *
+// Return value     : (const sample_log_header_t*) : Pointer to the header in flash                         *
+// **********************************************************************************************************
+static const sample_log_header_t* sample_log_header(uint32_t i_page);
+
+// **********************************************************************************************************
+// Function name    : sample_log_block                                                                      *
+// Description      : Get a block from its linear index.                                                    *
+// Argument         : (uint32_t) i_index: Block index                                                       *
+// Return value     : (const sample_log_block_t*) : Pointer to the block in flash                           *
+// **********************************************************************************************************
+static const sample_log_block_t* sample_log_block(uint32_t i_index);
+
+// **********************************************************************************************************
+// Function name    : sample_log_erase                                                                      *
+// Description      : Erase the page at the write position, the oldest page of the log.                     *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sample_log_erase(void);
+
+// **********************************************************************************************************
+// Function name    : sample_log_program                                                                    *
+// Description      : Program the oldest queued block at the write position, the page must be erased.       *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sample_log_program(void);
+
+// **********************************************************************************************************
+// Function name    : sample_log_dequeue                                                                    *
+// Description      : Remove the oldest block from the queue.                                               *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sample_log_dequeue(void);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : sample_log_init                                                                       *
+// Description      : Find the write and read positions of the log in flash.                                *
+// **********************************************************************************************************
+void sample_log_init(void)
+{
+    // Variable(s) declaration
+    const sample_log_header_t* p_header;
+    const sample_log_block_t* p_block;
+    uint32_t head_page;
+    uint32_t page;
+    uint32_t index;
+    uint32_t scan_length;
+    bool_e found;
+
+    // Variable(s) initialization
+    g_page_count = ((uint32_t) &_elog - (uint32_t) &_slog) / FLASH_PAGE_SIZE;
+    g_block_count = g_page_count * SAMPLE_LOG_BLOCKS_PER_PAGE;
+    g_block.count = 0u;
+    found = FALSE;
+    head_page = 0u;
+
+    // The page written last is the valid one with the highest sequence number
+    for (page = 0u ; page < g_page_count ; page++)
+    {
+        p_header = sample_log_header(page);
+        if ((p_header->magic == SAMPLE_LOG_MAGIC) &&
+            ((found == FALSE) || ((int16_t) (p_header->sequence - g_sequence) > 0)))
+        {
+            head_page = page;
+            g_sequence = p_header->sequence;
+            found = TRUE;
+        }
+    }
+
+    if (found == TRUE)
+    {
+        // Write after the last programmed block of the head page
+        g_write_index = head_page * SAMPLE_LOG_BLOCKS_PER_PAGE;
+        while ((g_write_index < ((head_page + 1u) * SAMPLE_LOG_BLOCKS_PER_PAGE)) &&
+               (sample_log_block(g_write_index)->count != SAMPLE_LOG_ERASED_COUNT))
+        {
+            g_write_index++;
+        }
+        g_write_index %= g_block_count;
+
+        // The oldest block not sent is searched from the page following the head page up to the write position
+        index = ((head_page + 1u) % g_page_count) * SAMPLE_LOG_BLOCKS_PER_PAGE;
+        scan_length = (g_write_index + g_block_count - index) % g_block_count;
+        if (scan_length == 0u)
+        {
+            // The head page is full: the whole log is scanned
+            scan_length = g_block_count;
+        }
+        g_read_index = g_write_index;
+        for ( ; scan_length != 0u ; scan_length--, index = (index + 1u) % g_block_count)
+        {
+            p_block = sample_log_block(index);
+            if ((sample_log_header(index / SAMPLE_LOG_BLOCKS_PER_PAGE)->magic == SAMPLE_LOG_MAGIC) &&
+                (p_block->count != SAMPLE_LOG_ERASED_COUNT) && (p_block->state != SAMPLE_LOG_STATE_SENT))
+            {
+                g_read_index = index;
+                break;
+            }
+        }
+
+        // The head page is full: the next one is erased before being written
+        if ((g_write_index % SAMPLE_LOG_BLOCKS_PER_PAGE) == 0u)
+        {
+            g_sequence++;
+            g_erase_pending = TRUE;
+        }
+    }
+    else
+    {
+        // Empty log: start from the first page
+        g_write_index = 0u;
+        g_read_index = 0u;
+        g_sequence = 0u;
+        g_erase_pending = TRUE;
+    }
+
+    // Nothing to mark yet. A pending erase is left to the first cycle, after the first measurement
+    g_mark_index = g_read_index;
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_append                                                                     *
+// Description      : Append a sample to the log, a closed block is queued for the flush.                   *
+// **********************************************************************************************************
+void sample_log_append(int16_t i_temperature, uint16_t i_humidity, uint32_t i_timestamp)
+{
+    // Variable(s) declaration
+    int32_t delta_temperature;
+    int32_t delta_humidity;
+    uint32_t elapsed;
+    uint32_t expected;
+    uint32_t interval;
+    bool_e fits;
+
+    // Check the sample can be delta encoded in the current block
+    fits = FALSE;
+    if ((g_block.count != 0u) && (g_block.count < SAMPLE_LOG_MAX_SAMPLES))
+    {
+        delta_temperature = (int32_t) i_temperature - g_last_temperature;
+        delta_humidity = (int32_t) i_humidity - (int32_t) g_last_humidity;
+        if ((delta_temperature >= INT8_MIN) && (delta_temperature <= INT8_MAX) &&
+            (delta_humidity >= INT8_MIN) && (delta_humidity <= INT8_MAX))
+        {
+            fits = TRUE;
+        }
+
+        // The second sample sets the interval, the next ones must follow it: a missed sample or a
+        // synchronization step starts a new block
+        elapsed = i_timestamp - g_block.timestamp;
+        interval = elapsed / g_block.count;
+        expected = (uint32_t) g_block.interval * g_block.count;
+        if ((interval > UINT16_MAX) ||
+            ((g_block.count > 1u) && (((elapsed > expected) ? (elapsed - expected) : (expected - elapsed)) >
+                                      ((uint32_t) g_block.interval >> SAMPLE_LOG_JITTER_SHIFT))))
+        {
+            fits = FALSE;
+        }
+    }
+
+    if (fits == TRUE)
+    {
+        // Store the deltas, the interval is averaged over the block so that the rounding does not add up
+        g_block.deltas[g_block.count - 1u][0] = (int8_t) delta_temperature;
+        g_block.deltas[g_block.count - 1u][1] = (int8_t) delta_humidity;
+        g_block.interval = (uint16_t) interval;
+        g_block.count++;
+    }
+    else
+    {
+        // Close the current block. The flush of the previous cycle left room for it in the queue, if the
+        // flushes fell behind the oldest block is programmed now rather than dropped
+        if (g_block.count != 0u)
+        {
+            if (g_queue_count == SAMPLE_LOG_QUEUE_DEPTH)
+            {
+                if (g_erase_pending == TRUE)
+                {
+                    sample_log_erase();
+                }
+                sample_log_program();
+            }
+            g_queue[g_queue_count] = g_block;
+            g_queue_count++;
+        }
+
+        // Start a new block with the sample
+        memset(&g_block, 0xFF, sizeof(g_block));
+        g_block.count = 1u;
+        g_block.timestamp = i_timestamp;
+        g_block.interval = 0u;
+        g_block.temperature = i_temperature;
+        g_block.humidity = i_humidity;
+    }
+
+    // The sample is the reference of the next delta
+    g_last_temperature = i_temperature;
+    g_last_humidity = i_humidity;
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_flush                                                                      *
+// Description      : Do the flash operations of the cycle (called once per cycle).                         *
+// **********************************************************************************************************
+void sample_log_flush(void)
+{
+    // Variable(s) declaration
+    const sample_log_block_t* p_block;
+    uint16_t sent;
+
+    // Variable(s) initialization
+    sent = SAMPLE_LOG_STATE_SENT;
+
+    // A block not acknowledged within the cycle is sent again
+    g_sending = FALSE;
+
+    // Mark the blocks acknowledged since the last cycle (a few tens of microseconds each), they are not sent
+    // again after a reset
+    for ( ; g_mark_index != g_read_index ; g_mark_index = (g_mark_index + 1u) % g_block_count)
+    {
+        p_block = sample_log_block(g_mark_index);
+        if ((p_block->count != SAMPLE_LOG_ERASED_COUNT) && (p_block->state != SAMPLE_LOG_STATE_SENT))
+        {
+            hw_flash_program((uint32_t) &p_block->state, &sent, sizeof(sent));
+        }
+    }
+
+    if (g_erase_pending == TRUE)
+    {
+        // Erase the next page
+        sample_log_erase();
+
+        // A full queue cannot wait for the next cycle (exceptional second operation)
+        if (g_queue_count == SAMPLE_LOG_QUEUE_DEPTH)
+        {
+            sample_log_program();
+        }
+    }
+    else if (g_queue_count != 0u)
+    {
+        // Program the oldest closed block
+        sample_log_program();
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_send                                                                       *
+// Description      : Send the next block of the backlog to the station.                                    *
+// **********************************************************************************************************
+bool_e sample_log_send(void)
+{
+    // Variable(s) declaration
+    const sample_log_block_t* p_block;
+    sample_log_block_t frame;
+    bool_e r_more;
+
+    // Variable(s) initialization
+    r_more = FALSE;
+
+    // One block at a time: the next one waits for the acknowledgment of the block sent
+    if (g_sending == FALSE)
+    {
+        if (g_read_index != g_write_index)
+        {
+            p_block = sample_log_block(g_read_index);
+            if ((p_block->count != SAMPLE_LOG_ERASED_COUNT) && (p_block->state != SAMPLE_LOG_STATE_SENT))
+            {
+                // Send the oldest block with a new sequence number in its reserved byte, it stays in the
+                // backlog until the station acknowledges this sequence number
+                frame = *p_block;
+                g_frame_sequence++;
+                frame.reserved = g_frame_sequence;
+                com_send_frame(COM_FRAME_LOG, &frame.count, SAMPLE_LOG_BLOCK_SIZE - sizeof(frame.state));
+                g_sending = TRUE;
+            }
+            else
+            {
+                // Nothing to send in this block, go on with the next one
+                g_read_index = (g_read_index + 1u) % g_block_count;
+                r_more = TRUE;
+            }
+        }
+        else if ((g_queue_count == 0u) && (g_block.count != 0u))
+        {
+            // The blocks in flash are acknowledged: close the block being filled, it is sent once programmed
+            g_queue[0] = g_block;
+            g_queue_count = 1u;
+            g_block.count = 0u;
+        }
+    }
+
+    // Report if the next block can be sent right away
+    return r_more;
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_ack                                                                        *
+// Description      : Take the acknowledgment of the station for the block sent.                            *
+// **********************************************************************************************************
+void sample_log_ack(uint8_t i_sequence)
+{
+    // The block leaves the backlog, it is marked in flash by the next flush. The acknowledgment of an older
+    // frame (sent again since) is ignored
+    if ((g_sending == TRUE) && (i_sequence == g_frame_sequence))
+    {
+        g_read_index = (g_read_index + 1u) % g_block_count;
+        g_sending = FALSE;
+    }
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : sample_log_header                                                                     *
+// Description      : Get the header of a page.                                                             *
+// **********************************************************************************************************
+static const sample_log_header_t* sample_log_header(uint32_t i_page)
+{
+    // Headers are at the start of the pages
+    return (const sample_log_header_t*) (&_slog + (i_page * FLASH_PAGE_SIZE));
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_block                                                                      *
+// Description      : Get a block from its linear index.                                                    *
+// **********************************************************************************************************
+static const sample_log_block_t* sample_log_block(uint32_t i_index)
+{
+    // Blocks follow the header of their page
+    return (const sample_log_block_t*) ((const uint8_t*) sample_log_header(i_index / SAMPLE_LOG_BLOCKS_PER_PAGE) +
+                                        sizeof(sample_log_header_t) + 
+                                        ((i_index % SAMPLE_LOG_BLOCKS_PER_PAGE) * SAMPLE_LOG_BLOCK_SIZE));
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_erase                                                                      *
+// Description      : Erase the page at the write position.                                                 *
+// **********************************************************************************************************
+static void sample_log_erase(void)
+{
+    // Variable(s) declaration
+    uint32_t page;
+
+    // Variable(s) initialization
+    page = g_write_index / SAMPLE_LOG_BLOCKS_PER_PAGE;
+
+    // The oldest page is dropped: move the read position out of it. With a single page the whole backlog goes
+    if ((g_read_index != g_write_index) && ((g_read_index / SAMPLE_LOG_BLOCKS_PER_PAGE) == page))
+    {
+        g_read_index = (((page + 1u) % g_page_count) * SAMPLE_LOG_BLOCKS_PER_PAGE);
+        g_mark_index = g_read_index;
+    }
+
+    // Erase the page
+    hw_flash_erase_page((uint32_t) &_slog + (page * FLASH_PAGE_SIZE));
+    g_erase_pending = FALSE;
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_program                                                                    *
+// Description      : Program the oldest queued block at the write position.                                *
+// **********************************************************************************************************
+static void sample_log_program(void)
+{
+    // Variable(s) declaration
+    sample_log_header_t header;
+    uint32_t page;
+
+    // Variable(s) initialization
+    page = g_write_index / SAMPLE_LOG_BLOCKS_PER_PAGE;
+
+    // The header is programmed with the first block of the page
+    if ((g_write_index % SAMPLE_LOG_BLOCKS_PER_PAGE) == 0u)
+    {
+        header.magic = SAMPLE_LOG_MAGIC;
+        header.sequence = g_sequence;
+        hw_flash_program((uint32_t) sample_log_header(page), &header, sizeof(header));
+    }
+
+    // Program the block and remove it from the queue
+    hw_flash_program((uint32_t) sample_log_block(g_write_index), &g_queue[0], SAMPLE_LOG_BLOCK_SIZE);
+    sample_log_dequeue();
+
+    // Move to the next block, the next page is erased at the next operation
+    g_write_index = (g_write_index + 1u) % g_block_count;
+    if ((g_write_index % SAMPLE_LOG_BLOCKS_PER_PAGE) == 0u)
+    {
+        g_sequence++;
+        g_erase_pending = TRUE;
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : sample_log_dequeue                                                                    *
+// Description      : Remove the oldest block from the queue.                                               *
+// **********************************************************************************************************
+static void sample_log_dequeue(void)
+{
+    // Variable(s) declaration
+    uint8_t index;
+
+    // Move the next blocks up
+    g_queue_count--;
+    for (index = 0u ; index < g_queue_count ; index++)
+    {
+        g_queue[index] = g_queue[index + 1u];
+    }
+}
+#endif
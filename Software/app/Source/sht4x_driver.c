@@ -8,7 +8,7 @@
 //                                               Include                                                    *
 // **********************************************************************************************************
 #include "sht4x_driver.h"
-#include <stdlib.h>
+#include "trace.h"
 
 // **********************************************************************************************************
 //                                               Defines                                                    *
@@ -17,6 +17,21 @@
 #define SHT4X_CRC8_POLYNOMIAL                  0x31u
 #define SHT4X_CRC8_INIT                        0xFFu
 
+// Conversion constants of a sensor, the calibration folded in: value = (multiplier . S >> 16) - offset for
+// the standard resolution (computed in 1/16 of the unit), value = multiplier . S / 65535 - offset for the
+// high resolution
+typedef struct
+{
+    uint32_t temperature_multiplier;
+    int32_t temperature_offset;
+    uint32_t humidity_multiplier;
+    int32_t humidity_offset;
+    uint32_t hr_temperature_multiplier;
+    int32_t hr_temperature_offset;
+    uint32_t hr_humidity_multiplier;
+    int32_t hr_humidity_offset;
+} sht4x_conversion_t;
+
 // Structure definition for the sensor handle
 typedef struct 
 {
@@ -24,6 +39,9 @@ typedef struct
     sht4x_send_function send_function;
     sht4x_receive_function receive_function;
     sht4x_delay delay_function;
+    sht4x_conversion_t conversion;
+    uint32_t serial_number;
+    uint16_t crc_errors;
 } sht4x_handle_s;
 
 // Address table
@@ -52,20 +70,61 @@ static const uint8_t sht4x_heater_commands[][2] =
 
 // Serial number command
 static const uint8_t sht4x_serial_number_command = 0x89;
+#define SHT4X_SERIAL_NUMBER_DELAY_MS          (1u)
 
 // Soft reset command
 static const uint8_t sht4x_soft_reset_command = 0x94;
 
 // Delay 
 #define SHT4X_MEASUREMENT_DELAY_MS            (10u)
+#define SHT4X_MEASUREMENT_DELAY_MEDIUM_MS     (5u)
+#define SHT4X_MEASUREMENT_DELAY_LOW_MS        (2u)
 #define SHT4X_HEATER_MEASUREMENT_DELAY_SHORT  (110u)
 #define SHT4X_HEATER_MEASUREMENT_DELAY_LONG   (1010u)
 
+// Normal mode conversion times (rounded up datasheet maximums)
+static const uint8_t sht4x_normal_delays[] = 
+{
+    SHT4X_MEASUREMENT_DELAY_LOW_MS,    // Low precision
+    SHT4X_MEASUREMENT_DELAY_MEDIUM_MS, // Medium precision
+    SHT4X_MEASUREMENT_DELAY_MS,        // High precision
+};
+
 // Conversion constants
 #define SHT4X_TEMPERATURE_MULTIPLIER          (1750u)
 #define SHT4X_TEMPERATURE_OFFSET              (450u)
 #define SHT4X_HUMIDITY_MULTIPLIER             (1250u)
 #define SHT4X_HUMIDITY_OFFSET                 (60u)
+#define SHT4X_HUMIDITY_MAX                    (1000)
+
+// High resolution conversion constants (0.01 unit), the full scale of the raw words is 2^16 - 1
+#define SHT4X_HR_TEMPERATURE_MULTIPLIER       (17500u)
+#define SHT4X_HR_TEMPERATURE_OFFSET           (4500)
+#define SHT4X_HR_HUMIDITY_MULTIPLIER          (12500u)
+#define SHT4X_HR_HUMIDITY_OFFSET              (600)
+#define SHT4X_HR_HUMIDITY_MAX                 (10000)
+#define SHT4X_HR_FULL_SCALE                   (65535u)
+
+// Calibration: fractional bits of the standard resolution constants and of the gains, gain of 1
+#define SHT4X_CALIBRATION_SHIFT               (4u)
+#define SHT4X_GAIN_SHIFT                      (15u)
+#define SHT4X_GAIN_ONE                        (32768u)
+
+// Conversion constants without calibration
+static const sht4x_conversion_t sht4x_datasheet_conversion =
+{
+    SHT4X_TEMPERATURE_MULTIPLIER << SHT4X_CALIBRATION_SHIFT,
+    SHT4X_TEMPERATURE_OFFSET << SHT4X_CALIBRATION_SHIFT,
+    SHT4X_HUMIDITY_MULTIPLIER << SHT4X_CALIBRATION_SHIFT,
+    SHT4X_HUMIDITY_OFFSET << SHT4X_CALIBRATION_SHIFT,
+    SHT4X_HR_TEMPERATURE_MULTIPLIER,
+    SHT4X_HR_TEMPERATURE_OFFSET,
+    SHT4X_HR_HUMIDITY_MULTIPLIER,
+    SHT4X_HR_HUMIDITY_OFFSET,
+};
+
+// Handles, one per address: no heap is needed, and a sensor initialized again keeps its handle
+static sht4x_handle_s sht4x_handles[sizeof(sht4x_addresses)];
 
 // **********************************************************************************************************
 //                                      Private fuctions prototype                                          *
@@ -79,6 +138,39 @@ static const uint8_t sht4x_soft_reset_command = 0x94;
 // **********************************************************************************************************
 static bool_e sht4x_crc8_check(uint8_t* i_p_data, uint8_t i_crc);
 
+// **********************************************************************************************************
+// Function name    : sht4x_divide_full_scale                                                               *
+// Description      : Rounded division by the full scale of the raw words without a division instruction.   *
+// Argument         : (uint32_t) i_value: Dividend (below 2^31)                                             *
+// Return value     : (uint32_t) : i_value / 65535 rounded to the nearest                                   *
+// **********************************************************************************************************
+static uint32_t sht4x_divide_full_scale(uint32_t i_value);
+
+#if SHT4X_CALIBRATION_ENABLED
+// **********************************************************************************************************
+// Function name    : sht4x_fold                                                                            *
+// Description      : Fold the calibration of a value into its conversion constants:                       *
+//                    gain . (multiplier . S - offset) + calibration offset.                                *
+// Argument         : (uint32_t) i_multiplier: Datasheet multiplier (below 2^16)                            *
+//                  : (int32_t) i_offset: Datasheet offset (positive, below 2^16)                           *
+//                  : (uint16_t) i_gain: Calibration gain in Q15                                            *
+//                  : (int32_t) i_calibration_offset: Calibration offset, in the unit of the offsets        *
+//                  : (uint32_t*) o_p_multiplier: Calibrated multiplier                                     *
+//                  : (int32_t*) o_p_offset: Calibrated offset                                              *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sht4x_fold(uint32_t i_multiplier, int32_t i_offset, uint16_t i_gain, int32_t i_calibration_offset,
+                       uint32_t* o_p_multiplier, int32_t* o_p_offset);
+
+// **********************************************************************************************************
+// Function name    : sht4x_scale_offset                                                                    *
+// Description      : Convert a calibration offset to the unit of the standard resolution constants.        *
+// Argument         : (int16_t) i_offset: Offset in 0.01 unit                                               *
+// Return value     : (int32_t) : Offset in 1/16 of 0.1 unit, rounded to the nearest                        *
+// **********************************************************************************************************
+static int32_t sht4x_scale_offset(int16_t i_offset);
+#endif
+
 // **********************************************************************************************************
 //                                           Public fuctions                                                *
 // **********************************************************************************************************
@@ -94,36 +186,33 @@ sht4x_handle_t* sht4x_init(sht4x_address_e i_address,
     // Variable declaration
     sht4x_handle_s* r_p_handle;
 
-    // Allocate memory for the handle
-    r_p_handle = (sht4x_handle_s*) malloc(sizeof(sht4x_handle_s));
+    // Variable initialization
+    r_p_handle = NULL;
 
-    // Check allocation
-    if (r_p_handle != NULL)
+    // Check the input parameters
+    if ((i_address < sizeof(sht4x_addresses)) &&
+        (i_send_function != NULL) && (i_receive_function != NULL) && (i_delay != NULL))
     {
-        // Check the input parameters
-        if (i_send_function != NULL && i_receive_function != NULL && i_delay != NULL)
-        {
-            // Initialize the handle
-            r_p_handle->address = i_address;
-            r_p_handle->send_function = i_send_function;
-            r_p_handle->receive_function = i_receive_function;
-            r_p_handle->delay_function = i_delay;
-        }
-        else
-        {
-            // Invalid parameters: free allocated memory and return NULL
-            free(r_p_handle);
-            r_p_handle = NULL;
-        }
+        // Initialize the handle of the address
+        r_p_handle = &sht4x_handles[i_address];
+        r_p_handle->address = i_address;
+        r_p_handle->send_function = i_send_function;
+        r_p_handle->receive_function = i_receive_function;
+        r_p_handle->delay_function = i_delay;
+
+        // Datasheet conversion until a calibration is set
+        r_p_handle->conversion = sht4x_datasheet_conversion;
+        r_p_handle->serial_number = 0u;
+        r_p_handle->crc_errors = 0u;
     }
 
-    // Return the newly created handle
+    // Return the handle
     return (sht4x_handle_t*) r_p_handle;
 }
 
 // **********************************************************************************************************
 // Function name    : sht4x_get_serial_number                                                               *
-// Description      : Get the sensor serial number.                                                         *
+// Description      : Read the sensor serial number, and keep it in the handle.                             *
 // **********************************************************************************************************
 status_e sht4x_get_serial_number(sht4x_handle_t* i_p_handle, uint32_t* o_p_serial_number)
 {
@@ -148,6 +237,9 @@ status_e sht4x_get_serial_number(sht4x_handle_t* i_p_handle, uint32_t* o_p_seria
         // Check status
         if (r_status == STATUS_OK)
         {
+            // Wait for the sensor to fetch the serial number
+            p_handle->delay_function(SHT4X_SERIAL_NUMBER_DELAY_MS);
+
             // Receive the serial number data
             r_status = p_handle->receive_function(sht4x_addresses[p_handle->address], data, 6u);
 
@@ -162,6 +254,7 @@ status_e sht4x_get_serial_number(sht4x_handle_t* i_p_handle, uint32_t* o_p_seria
                                         ((uint32_t)data[1] << 16u) |
                                         ((uint32_t)data[3] << 8u)  |
                                         ((uint32_t)data[4]);
+                    p_handle->serial_number = *o_p_serial_number;
 
                     // CRC are valid: update the status
                     r_status = STATUS_OK;
@@ -170,17 +263,20 @@ status_e sht4x_get_serial_number(sht4x_handle_t* i_p_handle, uint32_t* o_p_seria
                 {
                     // CRC error: update the status
                     r_status = STATUS_ERROR;
+                    TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_CRC);
                 }
             }
             else
             {
                 // Return error status
+                TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_RECEIVE);
                 return STATUS_ERROR;
             }
         }
         else
         {
             // Return error status
+            TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_SEND);
             return STATUS_ERROR;
         }
     }
@@ -188,12 +284,31 @@ status_e sht4x_get_serial_number(sht4x_handle_t* i_p_handle, uint32_t* o_p_seria
     {
         // Invalid handle: return error status
         r_status = STATUS_ERROR;
+        TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_HANDLE);
     }
 
     // Return the status of the operation
     return r_status;
 }
 
+// **********************************************************************************************************
+// Function name    : sht4x_get_cached_serial_number                                                        *
+// Description      : Get the serial number read last by sht4x_get_serial_number, without bus transfer.     *
+// **********************************************************************************************************
+uint32_t sht4x_get_cached_serial_number(const sht4x_handle_t* i_p_handle)
+{
+    return (i_p_handle != NULL) ? ((const sht4x_handle_s*) i_p_handle)->serial_number : 0u;
+}
+
+// **********************************************************************************************************
+// Function name    : sht4x_get_crc_errors                                                                  *
+// Description      : Get the number of measurement reads which failed their CRC.                           *
+// **********************************************************************************************************
+uint16_t sht4x_get_crc_errors(const sht4x_handle_t* i_p_handle)
+{
+    return (i_p_handle != NULL) ? ((const sht4x_handle_s*) i_p_handle)->crc_errors : 0u;
+}
+
 // **********************************************************************************************************
 // Function name    : sht4x_soft_reset                                                                      *
 // Description      : Perform a soft reset of the sensor.                                                   *
@@ -221,6 +336,7 @@ status_e sht4x_soft_reset(sht4x_handle_t* i_p_handle)
     {
         // Invalid handle: return error status
         r_status = STATUS_ERROR;
+        TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_HANDLE);
     }
 
 
@@ -236,16 +352,41 @@ status_e sht4x_read_temperature_humidity(sht4x_handle_t* i_p_handle,
                                          sht4x_precision_e i_precision, 
                                          int16_t* o_p_temperature, 
                                          uint16_t* o_p_humidity)
+{
+    // Variable(s) declaration
+    sht4x_handle_s* p_handle;
+    status_e r_status;
+
+    // Variable(s) initialization
+    p_handle = (sht4x_handle_s*) i_p_handle;
+
+    // Start the measurement
+    r_status = sht4x_start_measurement(i_p_handle, i_precision);
+
+    // Check status
+    if (r_status == STATUS_OK)
+    {
+        // Wait for measurement to complete
+        p_handle->delay_function(sht4x_normal_delays[i_precision]);
+
+        // Receive the measurement data
+        r_status = sht4x_read_measurement(i_p_handle, o_p_temperature, o_p_humidity);
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : sht4x_start_measurement                                                               *
+// Description      : Send the measurement command without waiting for the conversion to complete.         *
+// **********************************************************************************************************
+status_e sht4x_start_measurement(sht4x_handle_t* i_p_handle, sht4x_precision_e i_precision)
 {
     // Variable(s) declaration
     sht4x_handle_s* p_handle;
     status_e r_status;
     uint8_t command;
-    uint8_t data[6];
-    uint32_t raw_temperature;
-    uint32_t raw_humidity;
-    int32_t temp;
-    uint32_t hum;
 
     // Variable(s) initialization
     p_handle = (sht4x_handle_s*) i_p_handle;
@@ -258,85 +399,242 @@ status_e sht4x_read_temperature_humidity(sht4x_handle_t* i_p_handle,
 
         // Send the command
         r_status = p_handle->send_function(sht4x_addresses[p_handle->address], &command, 1u);
+    }
+    else
+    {
+        // Invalid handle: return error status
+        r_status = STATUS_ERROR;
+        TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_HANDLE);
+    }
 
-        // Check status
-        if (r_status == STATUS_OK)
-        {
-            // Wait for measurement to complete
-            p_handle->delay_function(SHT4X_MEASUREMENT_DELAY_MS);
+    // Return the status of the operation
+    return r_status;
+}
 
-            // Receive the measurement data
-            r_status = p_handle->receive_function(sht4x_addresses[p_handle->address], data, 6u);
+// **********************************************************************************************************
+// Function name    : sht4x_read_measurement                                                                *
+// Description      : Read the result of a measurement started with sht4x_start_measurement.               *
+// **********************************************************************************************************
+status_e sht4x_read_measurement(sht4x_handle_t* i_p_handle, int16_t* o_p_temperature, uint16_t* o_p_humidity)
+{
+    // Variable(s) declaration
+    status_e r_status;
+    uint16_t raw_temperature;
+    uint16_t raw_humidity;
 
-            // Check status
-            if (r_status == STATUS_OK)
-            {
-                // Check CRCs
-                if (sht4x_crc8_check(&data[0], data[2]) && sht4x_crc8_check(&data[3], data[5]))
-                { 
-                    // Combine raw temperature and humidity bytes
-                    raw_temperature = ((uint32_t)data[0] << 8u) | ((uint32_t)data[1]);
-                    raw_humidity    = ((uint32_t)data[3] << 8u) | ((uint32_t)data[4]);
-
-                    // Calculate temperature in 0.1 degree Celsius
-                    temp = ((int32_t)(raw_temperature * SHT4X_TEMPERATURE_MULTIPLIER) >> 16u) - 
-                           SHT4X_TEMPERATURE_OFFSET;
-
-                    // Store temperature value
-                    *o_p_temperature = (int16_t) temp;
-
-                    // Calculate humidity in 0.1 %RH
-                    hum = ((int32_t)(raw_humidity * SHT4X_HUMIDITY_MULTIPLIER) >> 16u) - 
-                          SHT4X_HUMIDITY_OFFSET;
-
-                    // Crop humidity to 0-1000 (0-100.0 %RH)
-                    if (hum > 1000u)
-                    {
-                        // Limit to 100%
-                        *o_p_humidity = 1000u;
-                    }   
-                    else if (hum < 0u)
-                    {
-                        // Limit to 0%
-                        *o_p_humidity = 0u;
-                    }
-                    else
-                    {
-                        // Valid humidity
-                        *o_p_humidity = (uint16_t) hum;
-                    }
+    // Receive the raw words
+    r_status = sht4x_read_measurement_raw(i_p_handle, &raw_temperature, &raw_humidity);
 
-                    // CRC are valid: update the status
-                    r_status = STATUS_OK;
-                }
-                else
-                {
-                    // CRC error: update the status
-                    r_status = STATUS_ERROR;
-                }
+    // Check status
+    if (r_status == STATUS_OK)
+    {
+        // Convert them
+        sht4x_convert(i_p_handle, raw_temperature, raw_humidity, o_p_temperature, o_p_humidity);
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : sht4x_read_measurement_raw                                                            *
+// Description      : Read the raw words of a measurement started with sht4x_start_measurement.            *
+// **********************************************************************************************************
+status_e sht4x_read_measurement_raw(sht4x_handle_t* i_p_handle, uint16_t* o_p_raw_temperature,
+                                    uint16_t* o_p_raw_humidity)
+{
+    // Variable(s) declaration
+    sht4x_handle_s* p_handle;
+    status_e r_status;
+    uint8_t data[6];
+
+    // Variable(s) initialization
+    p_handle = (sht4x_handle_s*) i_p_handle;
+
+    // Check handle validity
+    if (p_handle != NULL)
+    {
+        // Receive the measurement data
+        r_status = p_handle->receive_function(sht4x_addresses[p_handle->address], data, 6u);
+
+        // Check status
+        if (r_status == STATUS_OK)
+        {
+            // Check CRCs
+            if (sht4x_crc8_check(&data[0], data[2]) && sht4x_crc8_check(&data[3], data[5]))
+            { 
+                // Combine raw temperature and humidity bytes
+                *o_p_raw_temperature = (uint16_t) (((uint32_t) data[0] << 8u) | ((uint32_t) data[1]));
+                *o_p_raw_humidity    = (uint16_t) (((uint32_t) data[3] << 8u) | ((uint32_t) data[4]));
+
+                // CRC are valid: update the status
+                r_status = STATUS_OK;
             }
             else
             {
-                // Return error status
+                // CRC error: update the status and count it
                 r_status = STATUS_ERROR;
+                p_handle->crc_errors++;
+                TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_CRC);
             }
         }
         else
         {
             // Return error status
             r_status = STATUS_ERROR;
+            TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_RECEIVE);
         }
     }
     else
     {
         // Invalid handle: return error status
         r_status = STATUS_ERROR;
+        TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_HANDLE);
     }
 
     // Return the status of the operation
     return r_status;
 }
 
+// **********************************************************************************************************
+// Function name    : sht4x_convert                                                                         *
+// Description      : Convert the raw words to 0.1 degree Celsius and 0.1 %RH with the calibration.         *
+// **********************************************************************************************************
+void sht4x_convert(const sht4x_handle_t* i_p_handle, uint16_t i_raw_temperature, uint16_t i_raw_humidity,
+                   int16_t* o_p_temperature, uint16_t* o_p_humidity)
+{
+    // Variable(s) declaration
+    const sht4x_conversion_t* p_conversion;
+    int32_t temp;
+    int32_t hum;
+
+    // Variable(s) initialization
+    p_conversion = &((const sht4x_handle_s*) i_p_handle)->conversion;
+
+    // Calculate temperature in 0.1 degree Celsius, rounded down (arithmetic shift) like the datasheet
+    // constants without calibration
+    temp = ((int32_t) (((uint32_t) i_raw_temperature * p_conversion->temperature_multiplier) >> 16u) -
+            p_conversion->temperature_offset) >> SHT4X_CALIBRATION_SHIFT;
+
+    // Store temperature value
+    *o_p_temperature = (int16_t) temp;
+
+    // Calculate humidity in 0.1 %RH, signed as the offset makes the low codes negative
+    hum = ((int32_t) (((uint32_t) i_raw_humidity * p_conversion->humidity_multiplier) >> 16u) -
+           p_conversion->humidity_offset) >> SHT4X_CALIBRATION_SHIFT;
+
+    // Crop humidity to 0-1000 (0-100.0 %RH)
+    if (hum > SHT4X_HUMIDITY_MAX)
+    {
+        // Limit to 100%
+        hum = SHT4X_HUMIDITY_MAX;
+    }
+    else if (hum < 0)
+    {
+        // Limit to 0%
+        hum = 0;
+    }
+
+    // Store humidity value
+    *o_p_humidity = (uint16_t) hum;
+}
+
+// **********************************************************************************************************
+// Function name    : sht4x_convert_high_resolution                                                         *
+// Description      : Convert the raw words to 0.01 degree Celsius and 0.01 %RH, exact and rounded to the   *
+//                    nearest.                                                                              *
+// **********************************************************************************************************
+void sht4x_convert_high_resolution(const sht4x_handle_t* i_p_handle, uint16_t i_raw_temperature,
+                                   uint16_t i_raw_humidity, int16_t* o_p_temperature, uint16_t* o_p_humidity)
+{
+    // Variable(s) declaration
+    const sht4x_conversion_t* p_conversion;
+    int32_t hum;
+
+    // Variable(s) initialization
+    p_conversion = &((const sht4x_handle_s*) i_p_handle)->conversion;
+
+    // T = -45 + 175 . S / (2^16 - 1), in 0.01 degree Celsius
+    *o_p_temperature = (int16_t) ((int32_t) sht4x_divide_full_scale((uint32_t) i_raw_temperature *
+                                                                    p_conversion->hr_temperature_multiplier) -
+                                  p_conversion->hr_temperature_offset);
+
+    // RH = -6 + 125 . S / (2^16 - 1), in 0.01 %RH
+    hum = (int32_t) sht4x_divide_full_scale((uint32_t) i_raw_humidity *
+                                            p_conversion->hr_humidity_multiplier) -
+          p_conversion->hr_humidity_offset;
+
+    // Crop humidity to 0-10000 (0-100.00 %RH)
+    if (hum > SHT4X_HR_HUMIDITY_MAX)
+    {
+        // Limit to 100%
+        hum = SHT4X_HR_HUMIDITY_MAX;
+    }
+    else if (hum < 0)
+    {
+        // Limit to 0%
+        hum = 0;
+    }
+
+    // Store humidity value
+    *o_p_humidity = (uint16_t) hum;
+}
+
+#if SHT4X_CALIBRATION_ENABLED
+// **********************************************************************************************************
+// Function name    : sht4x_set_calibration                                                                 *
+// Description      : Fold a two-point calibration into the conversion constants of the sensor.             *
+// **********************************************************************************************************
+void sht4x_set_calibration(sht4x_handle_t* i_p_handle, const sht4x_calibration_t* i_p_calibration)
+{
+    // Variable(s) declaration
+    sht4x_handle_s* p_handle;
+    sht4x_conversion_t* p_conversion;
+
+    // Variable(s) initialization
+    p_handle = (sht4x_handle_s*) i_p_handle;
+
+    // Check handle validity
+    if (p_handle != NULL)
+    {
+        // Standard resolution, the offsets are converted to 1/16 of 0.1 unit
+        p_conversion = &p_handle->conversion;
+        sht4x_fold(sht4x_datasheet_conversion.temperature_multiplier,
+                   sht4x_datasheet_conversion.temperature_offset,
+                   i_p_calibration->temperature_gain, sht4x_scale_offset(i_p_calibration->temperature_offset),
+                   &p_conversion->temperature_multiplier, &p_conversion->temperature_offset);
+        sht4x_fold(sht4x_datasheet_conversion.humidity_multiplier, sht4x_datasheet_conversion.humidity_offset,
+                   i_p_calibration->humidity_gain, sht4x_scale_offset(i_p_calibration->humidity_offset),
+                   &p_conversion->humidity_multiplier, &p_conversion->humidity_offset);
+
+        // High resolution, the offsets are already in 0.01 unit
+        sht4x_fold(sht4x_datasheet_conversion.hr_temperature_multiplier,
+                   sht4x_datasheet_conversion.hr_temperature_offset, i_p_calibration->temperature_gain,
+                   i_p_calibration->temperature_offset, &p_conversion->hr_temperature_multiplier,
+                   &p_conversion->hr_temperature_offset);
+        sht4x_fold(sht4x_datasheet_conversion.hr_humidity_multiplier,
+                   sht4x_datasheet_conversion.hr_humidity_offset,
+                   i_p_calibration->humidity_gain, i_p_calibration->humidity_offset,
+                   &p_conversion->hr_humidity_multiplier, &p_conversion->hr_humidity_offset);
+    }
+    else
+    {
+        // Invalid handle
+        TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_HANDLE);
+    }
+}
+#endif
+
+// **********************************************************************************************************
+// Function name    : sht4x_get_measurement_time                                                            *
+// Description      : Get the conversion time of a measurement.                                             *
+// **********************************************************************************************************
+uint32_t sht4x_get_measurement_time(sht4x_precision_e i_precision)
+{
+    // Return the conversion time of the precision
+    return (uint32_t) sht4x_normal_delays[i_precision];
+}
+
 // **********************************************************************************************************   
 // Function name    : sht4x_read_temperature_humidity_heater                                                *
 // Description      : Read temperature and humidity from the sensor with heater enabled.                    *
@@ -350,12 +648,38 @@ status_e sht4x_read_temperature_humidity_heater(sht4x_handle_t* i_p_handle,
     // Variable(s) declaration
     sht4x_handle_s* p_handle;
     status_e r_status;
+
+    // Variable(s) initialization
+    p_handle = (sht4x_handle_s*) i_p_handle;
+
+    // Start the heater
+    r_status = sht4x_start_heater(i_p_handle, i_heater_power, i_heater_duration);
+
+    // Check status
+    if (r_status == STATUS_OK)
+    {
+        // Wait for measurement to complete depending on heater duration
+        p_handle->delay_function(sht4x_get_heater_time(i_heater_duration));
+
+        // Receive the measurement data, same format as a normal measurement
+        r_status = sht4x_read_measurement(i_p_handle, o_p_temperature, o_p_humidity);
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : sht4x_start_heater                                                                    *
+// Description      : Send the heater command without waiting for the end of the heating.                   *
+// **********************************************************************************************************
+status_e sht4x_start_heater(sht4x_handle_t* i_p_handle, sht4x_heater_power_e i_heater_power,
+                            sht4x_heater_duration_e i_heater_duration)
+{
+    // Variable(s) declaration
+    sht4x_handle_s* p_handle;
+    status_e r_status;
     uint8_t command;
-    uint8_t data[6];
-    uint32_t raw_temperature;
-    uint32_t raw_humidity;
-    int32_t temp;
-    uint32_t hum;
 
     // Variable(s) initialization
     p_handle = (sht4x_handle_s*) i_p_handle;
@@ -370,90 +694,34 @@ status_e sht4x_read_temperature_humidity_heater(sht4x_handle_t* i_p_handle,
         r_status = p_handle->send_function(sht4x_addresses[p_handle->address], &command, 1u);
 
         // Check status
-        if (r_status == STATUS_OK)
-        {
-            // Wait for measurement to complete depending on heater duration
-            if (i_heater_duration == SHT4x_HEATER_DURATION_0_1SEC)
-            {
-                // Wait for a short duration
-                p_handle->delay_function(SHT4X_HEATER_MEASUREMENT_DELAY_SHORT);
-            }
-            else
-            {
-                // Wait for a long duration
-                p_handle->delay_function(SHT4X_HEATER_MEASUREMENT_DELAY_LONG);
-            }
-
-            // Receive the measurement data
-            r_status = p_handle->receive_function(sht4x_addresses[p_handle->address], data, 6u);
-
-            // Check status
-            if (r_status == STATUS_OK)
-            {
-                // Check CRCs
-                if (sht4x_crc8_check(&data[0], data[2]) && sht4x_crc8_check(&data[3], data[5]))
-                { 
-                    // Combine raw temperature and humidity bytes
-                    raw_temperature = ((uint32_t) data[0] << 8u) | ((uint32_t) data[1]);
-                    raw_humidity    = ((uint32_t) data[3] << 8u) | ((uint32_t) data[4]);
-
-                    // Calculate temperature in 0.1 degree Celsius
-                    temp = ((int32_t) (raw_temperature * SHT4X_TEMPERATURE_MULTIPLIER) >> 16u) - 
-                           SHT4X_TEMPERATURE_OFFSET;
-
-                    // Store temperature value
-                    *o_p_temperature = (int16_t) temp;
-
-                    // Calculate humidity in 0.1 %RH
-                    hum = ((int32_t) (raw_humidity * SHT4X_HUMIDITY_MULTIPLIER) >> 16u) - SHT4X_HUMIDITY_OFFSET;
-
-                    // Crop humidity to 0-1000 (0-100.0 %RH)
-                    if (hum > 1000u)
-                    {
-                        // Limit to 100%
-                        hum = 1000u;
-                    }
-                    else if (hum < 0u)
-                    {
-                        // Limit to 0%
-                        hum = 0u;
-                    }
-                    else
-                    {
-                        // Valid humidity
-                        *o_p_humidity = (uint16_t) hum;
-                    }
-
-                    // CRC are valid: update the status
-                    r_status = STATUS_OK;
-                }
-                else
-                {
-                    // CRC error: update the status
-                    r_status = STATUS_ERROR;
-                }
-            }
-            else
-            {
-                // Return error status
-                r_status = STATUS_ERROR;
-            }
-        }
-        else
+        if (r_status != STATUS_OK)
         {
             // Return error status
             r_status = STATUS_ERROR;
+            TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_SEND);
         }
     }
     else
     {
         // Invalid handle: return error status
         r_status = STATUS_ERROR;
+        TRACE_EVENT(TRACE_EVENT_SHT4X_ERROR, TRACE_SHT4X_ERROR_HANDLE);
     }
 
     // Return the status of the operation
     return r_status;
 }
+
+// **********************************************************************************************************
+// Function name    : sht4x_get_heater_time                                                                 *
+// Description      : Get the time from the heater command to the measurement result.                       *
+// **********************************************************************************************************
+uint32_t sht4x_get_heater_time(sht4x_heater_duration_e i_heater_duration)
+{
+    // Heating then measurement
+    return (i_heater_duration == SHT4x_HEATER_DURATION_0_1SEC) ? SHT4X_HEATER_MEASUREMENT_DELAY_SHORT :
+                                                                 SHT4X_HEATER_MEASUREMENT_DELAY_LONG;
+}
     
 // **********************************************************************************************************
 //                                              Private fuctions                                            *
@@ -514,4 +782,54 @@ static bool_e sht4x_crc8_check(uint8_t* i_p_data, uint8_t i_crc)
 
     // Return the result
     return r_result;
-}
\ No newline at end of file
+}
+
+// **********************************************************************************************************
+// Function name    : sht4x_divide_full_scale                                                               *
+// Description      : Rounded division by the full scale of the raw words without a division instruction.   *
+// **********************************************************************************************************
+static uint32_t sht4x_divide_full_scale(uint32_t i_value)
+{
+    // The full scale is odd so a quotient never ends in exactly one half: adding half of it rounds to the
+    // nearest. Then x / (2^16 - 1) = (x + x / 2^16 + 1) / 2^16 rounded down, exact below 2^31 (the Cortex-M0
+    // has no divide instruction and the library division takes tens of cycles)
+    i_value += SHT4X_HR_FULL_SCALE / 2u;
+    return (i_value + (i_value >> 16) + 1u) >> 16;
+}
+
+#if SHT4X_CALIBRATION_ENABLED
+// **********************************************************************************************************
+// Function name    : sht4x_fold                                                                            *
+// Description      : Fold the calibration of a value into its conversion constants.                        *
+// **********************************************************************************************************
+static void sht4x_fold(uint32_t i_multiplier, int32_t i_offset, uint16_t i_gain, int32_t i_calibration_offset,
+                       uint32_t* o_p_multiplier, int32_t* o_p_offset)
+{
+    // The gain scales both constants (rounded to the nearest), the calibration offset lowers the offset
+    *o_p_multiplier = ((i_multiplier * i_gain) + (SHT4X_GAIN_ONE >> 1)) >> SHT4X_GAIN_SHIFT;
+    *o_p_offset = (int32_t) ((((uint32_t) i_offset * i_gain) + (SHT4X_GAIN_ONE >> 1)) >> SHT4X_GAIN_SHIFT) -
+                  i_calibration_offset;
+}
+
+// **********************************************************************************************************
+// Function name    : sht4x_scale_offset                                                                    *
+// Description      : Convert a calibration offset to the unit of the standard resolution constants.        *
+// **********************************************************************************************************
+static int32_t sht4x_scale_offset(int16_t i_offset)
+{
+    // Variable(s) declaration
+    uint32_t magnitude;
+    int32_t r_offset;
+
+    // x 16 / 10, rounded half away from zero, on the magnitude to avoid the signed division of the runtime
+    magnitude = (uint32_t) ((i_offset < 0) ? -i_offset : i_offset);
+    r_offset = (int32_t) (((magnitude << SHT4X_CALIBRATION_SHIFT) + 5u) / 10u);
+    if (i_offset < 0)
+    {
+        r_offset = -r_offset;
+    }
+
+    // Return the offset
+    return r_offset;
+}
+#endif
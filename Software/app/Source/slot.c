@@ -0,0 +1,101 @@
+// **********************************************************************************************************
+// File name         : slot.c                                                                               *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Transmission slots: the cycles of the nodes sharing a station line are aligned on    *
+//                   : the station time, each node in its own slot                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "slot.h"
+#include "main.h"
+#include "config.h"
+#include "clock.h"
+
+#if SLOT_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Phase error left alone (ms): the wakeup latency and the clock resolution would move the timer every cycle
+#define SLOT_TOLERANCE_MS                       (2)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Serial number of the node, gives the slot when none is assigned
+static uint32_t g_slot_serial;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : slot_init                                                                             *
+// Description      : Keep the serial number used when no slot is assigned.                                 *
+// **********************************************************************************************************
+void slot_init(uint32_t i_serial)
+{
+    g_slot_serial = i_serial;
+}
+
+// **********************************************************************************************************
+// Function name    : slot_is_enabled                                                                       *
+// Description      : Tell whether the transmissions are scheduled in slots.                                *
+// **********************************************************************************************************
+bool_e slot_is_enabled(void)
+{
+    return (CONFIG_GET(CONFIG_KEY_TX_SLOT_COUNT) != 0u) ? TRUE : FALSE;
+}
+
+// **********************************************************************************************************
+// Function name    : slot_align                                                                            *
+// Description      : Move the next wakeup to the start of the slot of the node.                            *
+// **********************************************************************************************************
+void slot_align(void)
+{
+    // Variable(s) declaration
+    uint32_t count;
+    uint32_t slot;
+    uint32_t period_ms;
+    uint32_t phase_ms;
+    int32_t error_ms;
+    uint32_t delay_us;
+    uint32_t prescaler;
+    uint32_t ticks;
+
+    // Variable(s) initialization
+    count = CONFIG_GET(CONFIG_KEY_TX_SLOT_COUNT);
+    period_ms = ge_config_period_us / 1000u;
+
+    // Free running until the station time is known
+    if ((count == 0u) || (period_ms == 0u) || (clock_is_synced() == FALSE))
+    {
+        return;
+    }
+
+    // Assigned slot, or derived from the serial (two nodes may then share a slot)
+    slot = CONFIG_GET(CONFIG_KEY_TX_SLOT);
+    slot = ((slot == SLOT_FROM_SERIAL) ? g_slot_serial : slot) % count;
+
+    // Phase of this wakeup from the start of the slot in the station period, late when positive. The
+    // station time wraps every 49 days, the cycle after the wrap is only aligned again
+    phase_ms = (clock_get_ms() - ((slot * period_ms) / count)) % period_ms;
+    error_ms = (int32_t) phase_ms;
+    if (phase_ms > (period_ms / 2u))
+    {
+        error_ms -= (int32_t) period_ms;
+    }
+    if ((error_ms <= SLOT_TOLERANCE_MS) && (error_ms >= -SLOT_TOLERANCE_MS))
+    {
+        return;
+    }
+
+    // Next wakeup one period after the start of the slot, counted on the local clock with the prescaler the
+    // timer runs with, as clock_get_local_us() does. The whole prescaler periods and the rest are converted
+    // apart to stay in 32 bits
+    delay_us = clock_to_local_us((uint32_t) ((int32_t) period_ms - error_ms));
+    prescaler = TIM->PSC + 1u;
+    ticks = ((delay_us / prescaler) * HW_SYSCLK_MHZ) + (((delay_us % prescaler) * HW_SYSCLK_MHZ) / prescaler);
+    hw_tim_set_remaining((ticks != 0u) ? ticks : 1u);
+}
+#endif
@@ -0,0 +1,187 @@
+// **********************************************************************************************************
+// File name         : stats.c                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Running statistics (count, min, max, mean, standard deviation) over a window         *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "stats.h"
+#include "clock.h"
+
+#if STATS_ENABLED
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Maximum number of values in a window
+#define STATS_COUNT_MAX                         (0xFFFFu)
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : stats_divide                                                                          *
+// Description      : Signed division rounded to the nearest.                                               *
+// Argument         : (int32_t) i_value: Dividend                                                           *
+//                  : (int32_t) i_divisor: Divisor (positive)                                               *
+// Return value     : (int32_t) : Quotient                                                                  *
+// **********************************************************************************************************
+static int32_t stats_divide(int32_t i_value, int32_t i_divisor);
+
+// **********************************************************************************************************
+// Function name    : stats_sqrt                                                                            *
+// Description      : Integer square root rounded to the nearest.                                           *
+// Argument         : (uint32_t) i_value: Value                                                             *
+// Return value     : (uint32_t) : Square root                                                              *
+// **********************************************************************************************************
+static uint32_t stats_sqrt(uint32_t i_value);
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : stats_reset                                                                           *
+// Description      : Start a new window.                                                                   *
+// **********************************************************************************************************
+void stats_reset(stats_t* o_p_stats)
+{
+    o_p_stats->count = 0u;
+    o_p_stats->min = INT16_MAX;
+    o_p_stats->max = INT16_MIN;
+    o_p_stats->mean = 0;
+    o_p_stats->m2 = 0u;
+}
+
+// **********************************************************************************************************
+// Function name    : stats_add                                                                             *
+// Description      : Add a value to the window (saturates at 65535 values).                                *
+// **********************************************************************************************************
+void stats_add(stats_t* io_p_stats, int16_t i_value)
+{
+    // Variable(s) declaration
+    int32_t value;
+    int32_t delta;
+
+    // A full window keeps its statistics
+    if (io_p_stats->count < STATS_COUNT_MAX)
+    {
+        // Extremes
+        if (i_value < io_p_stats->min)
+        {
+            io_p_stats->min = i_value;
+        }
+        if (i_value > io_p_stats->max)
+        {
+            io_p_stats->max = i_value;
+        }
+
+        // Welford update: mean += (x - mean) / n, m2 += (x - old mean) . (x - new mean)
+        // Both deviations have the same sign so the product is never negative
+        io_p_stats->count++;
+        value = (int32_t) i_value << STATS_MEAN_SHIFT;
+        delta = value - io_p_stats->mean;
+        io_p_stats->mean += stats_divide(delta, (int32_t) io_p_stats->count);
+        io_p_stats->m2 += (uint64_t) ((int64_t) delta * (value - io_p_stats->mean));
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : stats_mean                                                                            *
+// Description      : Mean of the window, with one more decimal than the values.                            *
+// **********************************************************************************************************
+int32_t stats_mean(const stats_t* i_p_stats)
+{
+    // From 1/256 to 1/10 of the unit
+    return stats_divide(i_p_stats->mean * 10, 1 << STATS_MEAN_SHIFT);
+}
+
+// **********************************************************************************************************
+// Function name    : stats_stddev                                                                          *
+// Description      : Population standard deviation of the window, with one more decimal than the values.  *
+// **********************************************************************************************************
+uint32_t stats_stddev(const stats_t* i_p_stats)
+{
+    // Variable(s) declaration
+    uint32_t r_stddev;
+    uint64_t variance;
+
+    // Variable(s) initialization
+    r_stddev = 0u;
+
+    // Variance in 1/100 of the unit squared: m2 . 100 / (65536 . n), the 64 bits division is done once per
+    // window only. It fits 32 bits while the values spread over less than 13000 units (the sensor spans 1750)
+    if (i_p_stats->count != 0u)
+    {
+        variance = clock_divide((i_p_stats->m2 * 100u) >> (2u * STATS_MEAN_SHIFT), i_p_stats->count);
+        r_stddev = stats_sqrt((variance > UINT32_MAX) ? UINT32_MAX : (uint32_t) variance);
+    }
+
+    // Return the standard deviation
+    return r_stddev;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : stats_divide                                                                          *
+// Description      : Signed division rounded to the nearest.                                               *
+// **********************************************************************************************************
+static int32_t stats_divide(int32_t i_value, int32_t i_divisor)
+{
+    // Variable(s) declaration
+    uint32_t magnitude;
+    uint32_t quotient;
+
+    // The magnitude is divided without sign so that the signed division of the runtime is not linked
+    magnitude = (i_value < 0) ? (0u - (uint32_t) i_value) : (uint32_t) i_value;
+    quotient = (magnitude + ((uint32_t) i_divisor / 2u)) / (uint32_t) i_divisor;
+
+    // Return the quotient with the sign of the value
+    return (i_value < 0) ? -(int32_t) quotient : (int32_t) quotient;
+}
+
+// **********************************************************************************************************
+// Function name    : stats_sqrt                                                                            *
+// Description      : Integer square root rounded to the nearest.                                           *
+// **********************************************************************************************************
+static uint32_t stats_sqrt(uint32_t i_value)
+{
+    // Variable(s) declaration
+    uint32_t r_root;
+    uint32_t remainder;
+    uint32_t bit;
+
+    // Bit by bit, from the highest power of 4 below the value
+    r_root = 0u;
+    remainder = i_value;
+    bit = 1u << 30;
+    while (bit > remainder)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0u)
+    {
+        if (remainder >= (r_root + bit))
+        {
+            remainder -= r_root + bit;
+            r_root = (r_root >> 1) + bit;
+        }
+        else
+        {
+            r_root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    // The remainder is value - root^2, round up above root + 1/2
+    if (remainder > r_root)
+    {
+        r_root++;
+    }
+
+    // Return the root
+    return r_root;
+}
+#endif
@@ -8,17 +8,115 @@
 //                                               Include                                                    *
 // **********************************************************************************************************
 #include "task.h"
+#include "main.h"
 #include "sht4x_driver.h"
+#include "com.h"
+#include "prof.h"
+#include "trace.h"
+#include "memory.h"
+#include "energy.h"
+#include "sample_log.h"
+#include "config.h"
+#include "fault.h"
+#include "psychro.h"
+#include "stats.h"
+#include "alarm.h"
+#include "heater.h"
+#include "fusion.h"
+#include "quality.h"
+#include "diag.h"
+#include "clock.h"
+#include "slot.h"
 
 // **********************************************************************************************************
 //                                               Defines                                                    *
 // **********************************************************************************************************
+// Summary size: count, then minimum, maximum, mean and standard deviation of both values
+#define TASK_SUMMARY_SIZE                       (18u)
+
+// Alarm size: active and changed flags, sample
+#define TASK_ALARM_SIZE                         (6u)
+
+// Fusion size: fitted, valid and disagreeing sensors
+#define TASK_FUSION_SIZE                        (3u)
+
+// Identity size: sensor address, identity generation, serial number
+#define TASK_IDENTITY_SIZE                      (6u)
+
+// Quality size: sensor address, quality flags, stuck, spike and CRC error counters
+#define TASK_QUALITY_SIZE                       (8u)
+
+// Cycles between two identity checks, a single sensor is checked at a time
+#define TASK_IDENTITY_PERIOD                    (30u)
+
+// Transfer timeout: bus time of the transfer rounded down, plus 2 ms for the SysTick granularity
+#define TASK_I2C_TIMEOUT_MS(size)               ((ENERGY_I2C_US((size), CONFIG_GET(CONFIG_KEY_I2C_SPEED)) /   \
+                                                  1000u) + 2u)
+
+// Measurement attempts per cycle, the recovery escalates at each failure:
+// 1: retry after the backoff, 2: bus clear, 3: bus clear and sensor soft reset
+// Worst case awake time of a failing cycle at high precision and 100 kHz: each attempt lasts at most 3 ms for
+// the command (busy bus wait included), 10 ms of conversion and 3 ms for the reading, so 4 x 16 ms, plus 7 ms
+// of backoff, 1 ms of soft reset and 3 bus clears of 0.1 ms: under 75 ms
+#define TASK_MAX_ATTEMPTS                       (4u)
+#define TASK_SOFT_RESET_DELAY_MS                (1u)
 
 // **********************************************************************************************************
 //                                              Variables                                                   *
 // **********************************************************************************************************
-// Driver handle
-sht4x_handle_t* g_sht4x_handle;
+// Driver handles, indexed by the sensor address, and the fitted sensors (bit n for the address n)
+static sht4x_handle_t* g_sht4x_handles[FUSION_SENSOR_COUNT];
+static uint8_t g_sensors;
+
+// Sensors which answered and which disagreed with the vote in the last cycle, reported when they change
+static uint8_t g_sensors_valid;
+static uint8_t g_sensors_outliers;
+
+// Identity generation, changed with the serial of any sensor and stamped into the measurement frames, cycles
+// since the last identity check and next sensor checked
+static uint8_t g_identity_generation;
+static uint8_t g_identity_counter;
+static uint8_t g_identity_next;
+
+// Raw words of each sensor, read by the last cycle
+static uint16_t g_raw_temperatures[FUSION_SENSOR_COUNT];
+static uint16_t g_raw_humidities[FUSION_SENSOR_COUNT];
+
+// Sample of the previous cycle and sensors averaged in it, shipped while the next conversion is running
+static int16_t g_temperature;
+static uint16_t g_humidity;
+static uint32_t g_timestamp;
+static uint8_t g_sensors_used;
+static uint8_t g_attempts;
+static bool_e g_message_pending = FALSE;
+
+// Statistics of the current window and cycles elapsed in it, the summary is shipped during the next conversion
+static stats_t g_stats_temperature;
+static stats_t g_stats_humidity;
+static uint16_t g_window_cycles;
+static bool_e g_summary_pending = FALSE;
+
+// Last sample sent, logged in flash if the station does not acknowledge it
+static int16_t g_sent_temperature;
+static uint16_t g_sent_humidity;
+static uint32_t g_sent_timestamp;
+static bool_e g_sent_waiting_ack = FALSE;
+
+// Link state, the backlog is sent while the station acknowledges the measurements
+static bool_e g_link_up = FALSE;
+
+// Cycles since the last heartbeat, heartbeats since the last diagnostic frame
+static uint8_t g_heartbeat_counter;
+static uint8_t g_diag_counter;
+
+// Time frame waiting for the slot of the node, the synchronization is broadcast to all the nodes
+static bool_e g_time_pending = FALSE;
+
+// First cycle after the reset, its sample is sent without waiting for the next cycle
+static bool_e g_first_cycle = TRUE;
+
+// Error code of the last failed I2C transfer (HW_I2C_ERROR_* flags)
+static uint8_t g_i2c_error;
 
 // **********************************************************************************************************
 //                                       Private prototype functions                                        *
@@ -51,6 +149,186 @@ status_e i2c_receive_function(uint8_t i_address, uint8_t* o_p_data, size_t i_siz
 // **********************************************************************************************************
 void delay_function(uint32_t i_delay_ms);
 
+// **********************************************************************************************************
+// Function name    : task_i2c_status                                                                       *
+// Description      : Keep the error code of a failed transfer and count it                                 *
+// Argument         : (status_e) i_status : Status of the transfer                                          *
+// Return value     : (status_e)    : The status of the operation                                           *
+// **********************************************************************************************************
+static status_e task_i2c_status(status_e i_status);
+
+// **********************************************************************************************************
+// Function name    : task_start_measurements                                                               *
+// Description      : Start the conversion of every fitted sensor, they convert in parallel                 *
+// Argument         : (sht4x_precision_e) i_precision : Measurement precision                               *
+//                  : (uint8_t*) o_p_started          : Sensors which started (bit n for the address n)     *
+// Return value     : (status_e)    : STATUS_OK if a sensor started, else the status of the last failure    *
+// **********************************************************************************************************
+static status_e task_start_measurements(sht4x_precision_e i_precision, uint8_t* o_p_started);
+
+// **********************************************************************************************************
+// Function name    : task_read_measurements                                                                *
+// Description      : Read the result of the started sensors                                                *
+// Argument         : (uint8_t*) io_p_sensors          : Started sensors, then the sensors read correctly   *
+//                  : (uint16_t*) o_p_raw_temperature : Raw temperature word of each sensor                 *
+//                  : (uint16_t*) o_p_raw_humidity    : Raw humidity word of each sensor                    *
+// Return value     : (status_e)    : STATUS_OK if a sensor was read, else the status of the last failure   *
+// **********************************************************************************************************
+static status_e task_read_measurements(uint8_t* io_p_sensors, uint16_t* o_p_raw_temperature,
+                                       uint16_t* o_p_raw_humidity);
+
+// **********************************************************************************************************
+// Function name    : task_measure                                                                          *
+// Description      : Complete measurement: start the conversions, wait for them and read the results       *
+// Argument         : (sht4x_precision_e) i_precision : Measurement precision                               *
+//                  : (uint16_t*) o_p_raw_temperature : Raw temperature word of each sensor                 *
+//                  : (uint16_t*) o_p_raw_humidity    : Raw humidity word of each sensor                    *
+//                  : (uint8_t*) o_p_sensors          : Sensors read correctly (bit n for the address n)    *
+// Return value     : (status_e)    : The status of the operation                                           *
+// **********************************************************************************************************
+static status_e task_measure(sht4x_precision_e i_precision, uint16_t* o_p_raw_temperature,
+                             uint16_t* o_p_raw_humidity, uint8_t* o_p_sensors);
+
+// **********************************************************************************************************
+// Function name    : task_convert                                                                          *
+// Description      : Convert the raw words of some sensors to a format, each with its own calibration      *
+// Argument         : (task_format_e) i_format      : Format (raw words are copied as is)                   *
+//                  : (uint8_t) i_sensors           : Converted sensors (bit n for the address n)           *
+//                  : (int32_t*) o_p_temperatures   : Temperature of each sensor                            *
+//                  : (int32_t*) o_p_humidities     : Humidity of each sensor                               *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_convert(task_format_e i_format, uint8_t i_sensors, int32_t* o_p_temperatures,
+                         int32_t* o_p_humidities);
+
+// **********************************************************************************************************
+// Function name    : task_calibrate                                                                        *
+// Description      : Load the calibration stored for the serial of each sensor into its conversion         *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_calibrate(void);
+
+// **********************************************************************************************************
+// Function name    : task_check_identity                                                                   *
+// Description      : Read again the serial of the sensors which answer after a failure, and of one sensor  *
+//                    in turn periodically, to detect a replaced probe before its sample is converted       *
+// Argument         : (uint8_t) i_sensors : Sensors which answered this cycle (bit n for the address n)     *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_check_identity(uint8_t i_sensors);
+
+// **********************************************************************************************************
+// Function name    : task_send_identity                                                                    *
+// Description      : Send the serial number of a sensor to the station                                     *
+// Argument         : (uint8_t) i_sensor : Sensor address                                                   *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_identity(uint8_t i_sensor);
+
+// **********************************************************************************************************
+// Function name    : task_check_quality                                                                    *
+// Description      : Leave the stuck and spiking samples out of the fused sample, and report the sensors   *
+//                    whose quality flags changed                                                           *
+// Argument         : (uint8_t) i_sensors : Sensors which answered this cycle (bit n for the address n)     *
+//                  : (const int32_t*) i_p_temperatures : Temperatures of the sensors (0.1 degree Celsius)  *
+//                  : (const int32_t*) i_p_humidities : Humidities of the sensors (0.1 %RH)                 *
+// Return value     : (uint8_t) : Sensors whose sample can be used                                          *
+// **********************************************************************************************************
+static uint8_t task_check_quality(uint8_t i_sensors, const int32_t* i_p_temperatures,
+                                  const int32_t* i_p_humidities);
+
+// **********************************************************************************************************
+// Function name    : task_send_quality                                                                     *
+// Description      : Send the quality flags and counters of a sensor to the station                        *
+// Argument         : (uint8_t) i_sensor : Sensor address                                                   *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_quality(uint8_t i_sensor);
+
+// **********************************************************************************************************
+// Function name    : task_recover                                                                          *
+// Description      : Backoff and recovery action before a new measurement attempt                          *
+// Argument         : (uint8_t) i_failures : Number of failed attempts in the cycle                         *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_recover(uint8_t i_failures);
+
+// **********************************************************************************************************
+// Function name    : task_send_sensor_error                                                                *
+// Description      : Send the sensor error frame of a cycle without measurement                            *
+// Argument         : (status_e) i_status  : Status of the last attempt                                     *
+//                  : (uint8_t) i_attempts : Number of attempts                                             *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_sensor_error(status_e i_status, uint8_t i_attempts);
+
+// **********************************************************************************************************
+// Function name    : task_elapsed_us                                                                       *
+// Description      : Time elapsed since a start point, precise to the microsecond for short durations      *
+// Argument         : (uint32_t) i_start_tick : SysTick value at the start point                            *
+//                  : (uint16_t) i_start_ts   : Timestamp timer value at the start point                    *
+// Return value     : (uint32_t)    : Elapsed time in microseconds                                          *
+// **********************************************************************************************************
+static uint32_t task_elapsed_us(uint32_t i_start_tick, uint16_t i_start_ts);
+
+// **********************************************************************************************************
+// Function name    : task_send_heartbeat                                                                   *
+// Description      : Send the heartbeat frame with the energy estimate                                     *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_heartbeat(void);
+
+// **********************************************************************************************************
+// Function name    : task_send_measurement                                                                 *
+// Description      : Send the pending sample to the station                                                *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_measurement(void);
+
+// **********************************************************************************************************
+// Function name    : task_send_boot                                                                        *
+// Description      : Send the boot frame with the latency from HAL_Init to the end of the first            *
+//                    measurement, successful or not, and the reset cause                                   *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_boot(void);
+
+// **********************************************************************************************************
+// Function name    : task_send_summary                                                                     *
+// Description      : Send the statistics of the last window to the station and start a new window          *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_summary(void);
+
+// **********************************************************************************************************
+// Function name    : task_send_alarm                                                                       *
+// Description      : Send the alarm state to the station right away                                        *
+// Argument         : (uint8_t) i_changed: Alarms raised or cleared by the sample                           *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_alarm(uint8_t i_changed);
+
+// **********************************************************************************************************
+// Function name    : task_send_fusion                                                                      *
+// Description      : Send the state of the fused sensors to the station                                    *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_send_fusion(void);
+
+// **********************************************************************************************************
+// Function name    : task_heat                                                                             *
+// Description      : Fire a heater pulse with the MCU asleep during the heating                            *
+// Argument         : (const heater_pulse_t*) i_p_pulse: Pulse                                              *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void task_heat(const heater_pulse_t* i_p_pulse);
+
 // **********************************************************************************************************
 //                                            Public fuctions                                               *
 // **********************************************************************************************************
@@ -60,8 +338,57 @@ void delay_function(uint32_t i_delay_ms);
 // **********************************************************************************************************
 void task_init(void)
 {
-    // Initialize the sensor handle
-    g_sht4x_handle = sht4x_init(SHT4x_A, &i2c_send_function, &i2c_receive_function, &delay_function);
+    // Variable(s) declaration
+    uint32_t serial;
+    uint32_t slot_serial;
+    uint8_t sensor;
+
+    // Variable(s) initialization
+    slot_serial = 0u;
+
+    // Fitted sensors: the fused ones, or the single sensor at its address
+    g_sensors = (FUSION_ENABLED != 0u) ? (uint8_t) CONFIG_GET(CONFIG_KEY_FUSION_SENSORS) : 0u;
+    if (g_sensors == 0u)
+    {
+        g_sensors = (uint8_t) (1u << CONFIG_GET(CONFIG_KEY_SENSOR_ADDRESS));
+    }
+    g_sensors_valid = g_sensors;
+
+    // Initialize their handles and read their serial once for the features which use it, it is kept in the
+    // handle
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((g_sensors & (1u << sensor)) != 0u)
+        {
+            g_sht4x_handles[sensor] = sht4x_init((sht4x_address_e) sensor, &i2c_send_function,
+                                                 &i2c_receive_function, &delay_function);
+            if ((TASK_IDENTITY_ENABLED != 0u) || (SHT4X_CALIBRATION_ENABLED != 0u) || (SLOT_ENABLED != 0u))
+            {
+                sht4x_get_serial_number(g_sht4x_handles[sensor], &serial);
+            }
+            if ((SLOT_ENABLED != 0u) && (slot_serial == 0u))
+            {
+                slot_serial = sht4x_get_cached_serial_number(g_sht4x_handles[sensor]);
+            }
+        }
+    }
+
+    // The serial of the first sensor tells the nodes apart when no transmission slot is assigned
+    slot_init(slot_serial);
+
+    // Calibrate them
+    task_calibrate();
+
+    // Find the backlog of the samples not acknowledged before the reset
+    sample_log_init();
+
+    // Start the first statistics window
+    stats_reset(&g_stats_temperature);
+    stats_reset(&g_stats_humidity);
+
+    // Load the alarm thresholds and the slew limits
+    alarm_init();
+    quality_init();
 }
 
 // **********************************************************************************************************
@@ -71,21 +398,398 @@ void task_init(void)
 void task(void)
 {
     // Variable(s) delcaration
-    int16_t temperature;
-    uint16_t humidity;
-    uint8_t message[4];
+    int32_t temperatures[FUSION_SENSOR_COUNT];
+    int32_t humidities[FUSION_SENSOR_COUNT];
+    uint8_t sensors;
+    uint8_t used;
+    uint8_t outliers;
+    uint32_t start_tick;
+    uint16_t start_ts;
+    uint32_t elapsed;
+    uint32_t conversion_ms;
+    sht4x_precision_e precision;
+    uint32_t cycle_tick;
+    uint16_t cycle_ts;
+    uint8_t attempts;
+    uint8_t alarm_changed;
+    uint32_t active_us;
+    heater_pulse_t pulse;
+    bool_e heat;
+    status_e status;
+
+    // Variable(s) initialization
+    precision = (sht4x_precision_e) CONFIG_GET(CONFIG_KEY_PRECISION);
+    conversion_ms = sht4x_get_measurement_time(precision);
+    attempts = 1u;
+    g_i2c_error = 0u;
+    heat = FALSE;
+    active_us = 0u;
+    heater_tick(ge_config_period_us);
+
+    // The wakeup is over
+    PROF_STOP(PROF_PHASE_WAKEUP);
+    TRACE_EVENT(TRACE_EVENT_TASK_START, 0u);
+    cycle_tick = HAL_GetTick();
+    cycle_ts = HW_TIMESTAMP_GET();
 
-    // Execute the task by getting the temperature and humidity
-    sht4x_read_temperature_humidity(g_sht4x_handle, SHT4x_PRECISION_HIGH, &temperature, &humidity);
+    // Keep the wakeups in the slot of the node, the frames of the cycle are sent from here
+    slot_align();
 
-    // Fill the message for the UART
-    message[0] = (uint8_t)  (temperature & 0x00FF);
-    message[1] = (uint8_t) ((temperature >> 8) & 0x00FF);
-    message[2] = (uint8_t)  (humidity & 0x00FF);
-    message[3] = (uint8_t) ((humidity >> 8) & 0x00FF);
+    // Start the conversions first so that the sensors work while the previous result is sent
+    status = task_start_measurements(precision, &sensors);
+    start_tick = HAL_GetTick();
+    start_ts = HW_TIMESTAMP_GET();
 
-    // Send the temperature and humdity over UART
-    HAL_UART_Transmit(&ge_hw_uart_handle, message, 4, 100);
+    // The station did not acknowledge the last sample: the link is down, keep the sample in the log
+    if (g_sent_waiting_ack == TRUE)
+    {
+        sample_log_append(g_sent_temperature, g_sent_humidity, g_sent_timestamp);
+        g_sent_waiting_ack = FALSE;
+        g_link_up = FALSE;
+    }
+
+    // In slots the backlog is not streamed between the cycles: one block goes ahead of the frames of the
+    // cycle, so that its acknowledgment comes before the one of the measurement
+    if ((slot_is_enabled() == TRUE) && (g_link_up == TRUE))
+    {
+        (void) sample_log_send();
+    }
+
+    // Send the temperature and humdity of the previous cycle over UART during the conversion
+    if (g_message_pending == TRUE)
+    {
+        PROF_START(PROF_PHASE_UART_TX);
+        task_send_measurement();
+        PROF_STOP(PROF_PHASE_UART_TX);
+        g_message_pending = FALSE;
+    }
+
+    // Or the summary of the window completed by the previous cycle
+    if (g_summary_pending == TRUE)
+    {
+        PROF_START(PROF_PHASE_UART_TX);
+        task_send_summary();
+        PROF_STOP(PROF_PHASE_UART_TX);
+        g_summary_pending = FALSE;
+    }
+
+    // Check the conversion has been started
+    if (status == STATUS_OK)
+    {
+        // Wait for the remaining part of the conversion time only, counted on the 1 MHz timestamp timer: the
+        // SysTick may step right after the start and end the wait up to 1 ms before the conversion
+        PROF_START(PROF_PHASE_CONVERSION_WAIT);
+        elapsed = task_elapsed_us(start_tick, start_ts);
+        while (elapsed < (conversion_ms * 1000u))
+        {
+            elapsed = task_elapsed_us(start_tick, start_ts);
+        }
+        PROF_STOP(PROF_PHASE_CONVERSION_WAIT);
+        energy_add(ENERGY_STATE_CONVERSION, conversion_ms * 1000u);
+
+        // Get the raw temperatures and humidities (the CRC/convert phase is started by the receive function)
+        status = task_read_measurements(&sensors, g_raw_temperatures, g_raw_humidities);
+    }
+
+    // Recover and retry within the attempt budget of the cycle
+    while ((status != STATUS_OK) && (attempts < TASK_MAX_ATTEMPTS))
+    {
+        task_recover(attempts);
+        attempts++;
+        DIAG_COUNT(DIAG_COUNTER_RETRIES);
+        status = task_measure(precision, g_raw_temperatures, g_raw_humidities, &sensors);
+    }
+
+    // A sensor failing its transfer or its CRC is left out, the others still give the sample
+    if (status == STATUS_OK)
+    {
+        // A probe may have been replaced: its sample must be converted with its own calibration
+        if (TASK_IDENTITY_ENABLED != 0u)
+        {
+            task_check_identity(sensors);
+        }
+
+        // Vote between the calibrated samples of the sensors which answered, a single frame carries the fused
+        // sample
+        task_convert(TASK_FORMAT_STANDARD, sensors, temperatures, humidities);
+        sensors = task_check_quality(sensors, temperatures, humidities);
+        outliers = fusion_vote(temperatures, humidities, sensors, &used);
+
+        // Report a sensor which stops answering or agreeing, and its return
+        if ((sensors != g_sensors_valid) || (outliers != g_sensors_outliers))
+        {
+            g_sensors_valid = sensors;
+            g_sensors_outliers = outliers;
+            if (FUSION_ENABLED != 0u)
+            {
+                task_send_fusion();
+            }
+        }
+    }
+
+    if ((status == STATUS_OK) && ((heater_is_settling() == TRUE) || (sensors == 0u)))
+    {
+        // The sensor still cools down after a heater pulse or every sample is rejected: discard the cycle
+        alarm_missed();
+    }
+    else if (status == STATUS_OK)
+    {
+        // Keep the sample, it is sent during the next conversion: the sensors averaged in it give the raw
+        // and high resolution formats, the fused sample is used for the log and the derived values
+        DIAG_COUNT(DIAG_COUNTER_SAMPLES);
+        g_timestamp = clock_get_ms();
+        g_sensors_used = used;
+        g_temperature = (int16_t) fusion_mean(temperatures, used);
+        g_humidity = (uint16_t) fusion_mean(humidities, used);
+        PROF_STOP(PROF_PHASE_CONVERT);
+        g_attempts = attempts;
+
+        // A raised or cleared alarm is pushed at once, ahead of the pipelined, aggregated and logged frames
+        alarm_changed = alarm_check(g_temperature, g_humidity);
+        if (alarm_changed != 0u)
+        {
+            task_send_alarm(alarm_changed);
+        }
+
+        // Send every sample, or only aggregate it in the window
+        if ((STATS_ENABLED == 0u) || (CONFIG_GET(CONFIG_KEY_STATS_WINDOW) == 0u))
+        {
+            g_message_pending = TRUE;
+        }
+        else
+        {
+            stats_add(&g_stats_temperature, g_temperature);
+            stats_add(&g_stats_humidity, (int16_t) g_humidity);
+        }
+
+        // Check whether the sensor has stayed wet for too long
+        heat = heater_request(g_humidity, &pulse);
+
+        // Except after the reset: no previous cycle is sent, so send the first sample now
+        if (g_first_cycle == TRUE)
+        {
+            task_send_measurement();
+            g_message_pending = FALSE;
+        }
+    }
+    else
+    {
+        // No measurement this cycle: report the failure instead of a sample, the identity of the sensors is
+        // checked again when they answer
+        task_send_sensor_error(status, attempts);
+        alarm_missed();
+        task_check_quality(0u, temperatures, humidities);
+        g_sensors_valid = 0u;
+    }
+
+    // The boot frame follows the first cycle whatever its outcome
+    if (g_first_cycle == TRUE)
+    {
+        task_send_boot();
+        g_first_cycle = FALSE;
+    }
+
+    // The window is counted in cycles so that the summaries keep a fixed period, the failed cycles only
+    // lower the count of the summary
+    if ((STATS_ENABLED != 0u) && (CONFIG_GET(CONFIG_KEY_STATS_WINDOW) != 0u))
+    {
+        g_window_cycles++;
+        if (g_window_cycles >= CONFIG_GET(CONFIG_KEY_STATS_WINDOW))
+        {
+            g_window_cycles = 0u;
+            g_summary_pending = TRUE;
+        }
+    }
+
+    // Dry the sensor once the frames of the cycle are out. The MCU sleeps during the pulse without SysTick,
+    // longer than the timestamp timer wraps: the active time is counted apart before and after it
+    if (heat == TRUE)
+    {
+        active_us = task_elapsed_us(cycle_tick, cycle_ts);
+        task_heat(&pulse);
+        cycle_tick = HAL_GetTick();
+        cycle_ts = HW_TIMESTAMP_GET();
+    }
+
+    // The flash operations of the log, all of them are done here once per cycle
+    sample_log_flush();
+
+    // And the reply to the last synchronization
+    if (g_time_pending == TRUE)
+    {
+        clock_report();
+        g_time_pending = FALSE;
+    }
+
+    // Supervise the baudrate now that the frames of the cycle are out
+    com_tick(g_link_up);
+
+    // Send the heartbeat periodically, and the counters every few heartbeats
+    if (++g_heartbeat_counter >= TASK_HEARTBEAT_PERIOD)
+    {
+        g_heartbeat_counter = 0u;
+        task_send_heartbeat();
+        if (++g_diag_counter >= TASK_DIAG_PERIOD)
+        {
+            g_diag_counter = 0u;
+            diag_report();
+        }
+    }
+
+    // Close the cycle in the energy estimate and the time counters
+    active_us += task_elapsed_us(cycle_tick, cycle_ts);
+    energy_add(ENERGY_STATE_ACTIVE, active_us);
+    energy_cycle_end(ge_config_period_us);
+    diag_add_time(DIAG_COUNTER_ACTIVE_MS, active_us);
+    diag_add_time(DIAG_COUNTER_SLEEP_MS,
+                  (ge_config_period_us > active_us) ? (ge_config_period_us - active_us) : 0u);
+
+    // Record the end of the cycle with its status
+    TRACE_EVENT(TRACE_EVENT_TASK_END, status);
+}
+
+// **********************************************************************************************************
+// Function name    : task_process_commands                                                                 *
+// Description      : Process the commands received from the station                                        *
+// **********************************************************************************************************
+void task_process_commands(void)
+{
+    // Variable(s) declaration
+    com_command_t command;
+
+    // Process the received command, if any
+    if (com_get_command(&command) == TRUE)
+    {
+        TRACE_EVENT(TRACE_EVENT_COMMAND, command.type);
+        switch (command.type)
+        {
+            case COM_COMMAND_ACK:
+                // A log frame is acknowledged with its sequence number as payload, a measurement without
+                // payload
+                if (command.size != 0u)
+                {
+                    sample_log_ack(command.payload[0]);
+                }
+                else
+                {
+                    g_sent_waiting_ack = FALSE;
+                    g_link_up = TRUE;
+                }
+                break;
+
+            case COM_COMMAND_PROFILE:
+                // Send the per-phase timing report
+                PROF_REPORT();
+                break;
+
+            case COM_COMMAND_TRACE:
+                // Send the event trace
+                trace_dump();
+                break;
+
+            case COM_COMMAND_TRACE_MASK:
+                // Select the recorded events (32 bits, little endian)
+                if (command.size == 4u)
+                {
+                    ge_trace_mask = com_get_u32(command.payload);
+                }
+                break;
+
+            case COM_COMMAND_MEMORY:
+                // Send the RAM usage
+                memory_report();
+                break;
+
+            case COM_COMMAND_CONFIG:
+                // Send the parameters
+                config_report();
+                break;
+
+            case COM_COMMAND_CONFIG_SET:
+                // Store a parameter (key, 32 bits value in little endian), then send the parameters back
+                if (command.size == 5u)
+                {
+                    config_set((config_key_e) command.payload[0], com_get_u32(&command.payload[1]));
+
+                    // The thresholds follow the new parameters. The wakeup period, base of the rate and slew
+                    // limits, only changes at the next reset with the timer
+                    alarm_init();
+
+                    // A calibration applies at once as well
+                    if ((command.payload[0] >= CONFIG_KEY_CALIBRATION_SERIAL_0) &&
+                        (command.payload[0] <= CONFIG_KEY_CALIBRATION_HUMIDITY_2))
+                    {
+                        task_calibrate();
+                    }
+                }
+                config_report();
+                break;
+
+            case COM_COMMAND_DIAG:
+                // Send the health counters
+                diag_report();
+                break;
+
+            case COM_COMMAND_TIME:
+                // Align the clock to the station time (32 bits, little endian), then report the correction
+                if (command.size == 4u)
+                {
+                    clock_sync(com_get_u32(command.payload), command.time_us);
+                }
+
+                // In slots the nodes would all answer together: the report waits for the slot
+                if (slot_is_enabled() == TRUE)
+                {
+                    g_time_pending = TRUE;
+                }
+                else
+                {
+                    clock_report();
+                }
+                break;
+
+            case COM_COMMAND_BAUDRATE:
+                // Switch the baudrate (32 bits, little endian), the answer goes out at the current rate
+                if (command.size == 4u)
+                {
+                    com_set_baudrate(com_get_u32(command.payload));
+                }
+                break;
+
+            case COM_COMMAND_RESET:
+                // Restart to apply the hardware parameters
+                NVIC_SystemReset();
+                break;
+
+            default:
+                // Unknown command: ignore it
+                break;
+        }
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : task_background                                                                       *
+// Description      : Background work done between the cycles                                               *
+// **********************************************************************************************************
+bool_e task_background(void)
+{
+    // Variable(s) declaration
+    bool_e r_busy;
+
+    // Stream the backlog of the log while the link is up, unless it must wait for the slot of the node or for
+    // the acknowledgment of the measurement
+    if ((g_link_up == TRUE) && (g_sent_waiting_ack == FALSE) && (slot_is_enabled() == FALSE))
+    {
+        r_busy = sample_log_send();
+    }
+    else
+    {
+        r_busy = FALSE;
+    }
+
+    // Return TRUE if there is more to do
+    return r_busy;
 }
 
 // **********************************************************************************************************
@@ -98,16 +802,12 @@ status_e i2c_send_function(uint8_t i_address, uint8_t* i_p_data, size_t i_size)
     status_e r_status;
 
     // Implement the I2C send functionality here
-    if (HAL_OK == HAL_I2C_Master_Transmit(&ge_hw_i2c_handle, i_address << 1, i_p_data, i_size, HAL_MAX_DELAY))
-    {
-        // Success: update the status
-        r_status = STATUS_OK;
-    }
-    else
-    {
-        // Error: update the status
-        r_status = STATUS_ERROR;
-    }
+    PROF_START(PROF_PHASE_I2C_WRITE);
+    r_status = task_i2c_status(hw_i2c_transfer(i_address, i_p_data, i_size, FALSE,
+                                               TASK_I2C_TIMEOUT_MS(i_size)));
+    PROF_STOP(PROF_PHASE_I2C_WRITE);
+    energy_add(ENERGY_STATE_I2C, ENERGY_I2C_US(i_size, CONFIG_GET(CONFIG_KEY_I2C_SPEED)));
+    TRACE_EVENT(TRACE_EVENT_I2C_SEND, r_status);
 
     // Retrun the status of the operation
     return r_status;
@@ -123,16 +823,15 @@ status_e i2c_receive_function(uint8_t i_address, uint8_t* o_p_data, size_t i_siz
     status_e r_status;
 
     // Implement the I2C receive functionality here
-    if (HAL_OK == HAL_I2C_Master_Receive(&ge_hw_i2c_handle, i_address << 1, o_p_data, i_size, HAL_MAX_DELAY))
-    {
-        // Success: update the status
-        r_status = STATUS_OK;
-    }
-    else
-    {
-        // Error: update the status
-        r_status = STATUS_ERROR;
-    }
+    PROF_START(PROF_PHASE_I2C_READ);
+    r_status = task_i2c_status(hw_i2c_transfer(i_address, o_p_data, i_size, TRUE,
+                                               TASK_I2C_TIMEOUT_MS(i_size)));
+    PROF_STOP(PROF_PHASE_I2C_READ);
+    energy_add(ENERGY_STATE_I2C, ENERGY_I2C_US(i_size, CONFIG_GET(CONFIG_KEY_I2C_SPEED)));
+    TRACE_EVENT(TRACE_EVENT_I2C_RECEIVE, r_status);
+
+    // The driver checks the CRC and converts the data right after the reception
+    PROF_START(PROF_PHASE_CONVERT);
 
     // Retrun the status of the operation
     return r_status;
@@ -147,3 +846,706 @@ void delay_function(uint32_t i_delay_ms)
     // Implement the delay functionality here
     HAL_Delay(i_delay_ms);
 }
+
+// **********************************************************************************************************
+// Function name    : task_i2c_status                                                                       *
+// Description      : Keep the error code of a failed transfer and count it                                 *
+// **********************************************************************************************************
+static status_e task_i2c_status(status_e i_status)
+{
+    // Keep the error code (NACK, bus error, arbitration loss, timeout) for the error frame and count it
+    if (i_status != STATUS_OK)
+    {
+        g_i2c_error = ge_hw_i2c_error;
+        DIAG_COUNT(DIAG_COUNTER_I2C_ERRORS);
+        if ((g_i2c_error & HW_I2C_ERROR_NACK) != 0u)
+        {
+            DIAG_COUNT(DIAG_COUNTER_I2C_NACKS);
+        }
+    }
+
+    // Return the status
+    return i_status;
+}
+
+// **********************************************************************************************************
+// Function name    : task_start_measurements                                                               *
+// Description      : Start the conversion of every fitted sensor, they convert in parallel                 *
+// **********************************************************************************************************
+static status_e task_start_measurements(sht4x_precision_e i_precision, uint8_t* o_p_started)
+{
+    // Variable(s) declaration
+    uint8_t sensor;
+    status_e status;
+    status_e r_status;
+
+    // Variable(s) initialization
+    *o_p_started = 0u;
+    r_status = STATUS_ERROR;
+
+    // Each command is a single byte, the sensors then convert at the same time
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((g_sensors & (1u << sensor)) != 0u)
+        {
+            status = sht4x_start_measurement(g_sht4x_handles[sensor], i_precision);
+            if (status == STATUS_OK)
+            {
+                *o_p_started |= (uint8_t) (1u << sensor);
+            }
+            else
+            {
+                r_status = status;
+            }
+        }
+    }
+
+    // Return the status
+    return (*o_p_started != 0u) ? STATUS_OK : r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : task_read_measurements                                                                *
+// Description      : Read the result of the started sensors                                                *
+// **********************************************************************************************************
+static status_e task_read_measurements(uint8_t* io_p_sensors, uint16_t* o_p_raw_temperature,
+                                       uint16_t* o_p_raw_humidity)
+{
+    // Variable(s) declaration
+    uint16_t crc_errors;
+    uint8_t sensor;
+    status_e status;
+    status_e r_status;
+
+    // Variable(s) initialization
+    r_status = STATUS_ERROR;
+
+    // Drop the sensors whose transfer or CRC fails, the CRC failures feed the error rate of the sensor
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((*io_p_sensors & (1u << sensor)) != 0u)
+        {
+            crc_errors = sht4x_get_crc_errors(g_sht4x_handles[sensor]);
+            status = sht4x_read_measurement_raw(g_sht4x_handles[sensor], &o_p_raw_temperature[sensor],
+                                                &o_p_raw_humidity[sensor]);
+            if (sht4x_get_crc_errors(g_sht4x_handles[sensor]) != crc_errors)
+            {
+                DIAG_COUNT(DIAG_COUNTER_CRC_ERRORS);
+                quality_read(sensor, TRUE);
+            }
+            else
+            {
+                quality_read(sensor, FALSE);
+            }
+            if (status != STATUS_OK)
+            {
+                *io_p_sensors &= (uint8_t) ~(1u << sensor);
+                r_status = status;
+            }
+        }
+    }
+
+    // Return the status
+    return (*io_p_sensors != 0u) ? STATUS_OK : r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : task_measure                                                                          *
+// Description      : Complete measurement: start the conversions, wait for them and read the results       *
+// **********************************************************************************************************
+static status_e task_measure(sht4x_precision_e i_precision, uint16_t* o_p_raw_temperature,
+                             uint16_t* o_p_raw_humidity, uint8_t* o_p_sensors)
+{
+    // Variable(s) declaration
+    status_e r_status;
+
+    // Start the conversions
+    r_status = task_start_measurements(i_precision, o_p_sensors);
+    if (r_status == STATUS_OK)
+    {
+        // Wait for them and read the results
+        delay_function(sht4x_get_measurement_time(i_precision));
+        energy_add(ENERGY_STATE_CONVERSION, sht4x_get_measurement_time(i_precision) * 1000u);
+        r_status = task_read_measurements(o_p_sensors, o_p_raw_temperature, o_p_raw_humidity);
+    }
+
+    // Return the status
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : task_convert                                                                          *
+// Description      : Convert the raw words of some sensors to a format, each with its own calibration      *
+// **********************************************************************************************************
+static void task_convert(task_format_e i_format, uint8_t i_sensors, int32_t* o_p_temperatures,
+                         int32_t* o_p_humidities)
+{
+    // Variable(s) declaration
+    int16_t temperature;
+    uint16_t humidity;
+    uint8_t sensor;
+
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((i_sensors & (1u << sensor)) != 0u)
+        {
+            if (i_format == TASK_FORMAT_RAW)
+            {
+                // Passthrough
+                o_p_temperatures[sensor] = g_raw_temperatures[sensor];
+                o_p_humidities[sensor] = g_raw_humidities[sensor];
+            }
+            else
+            {
+                if (i_format == TASK_FORMAT_HIGH_RESOLUTION)
+                {
+                    sht4x_convert_high_resolution(g_sht4x_handles[sensor], g_raw_temperatures[sensor],
+                                                  g_raw_humidities[sensor], &temperature, &humidity);
+                }
+                else
+                {
+                    sht4x_convert(g_sht4x_handles[sensor], g_raw_temperatures[sensor],
+                                  g_raw_humidities[sensor], &temperature, &humidity);
+                }
+                o_p_temperatures[sensor] = temperature;
+                o_p_humidities[sensor] = humidity;
+            }
+        }
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : task_calibrate                                                                        *
+// Description      : Load the calibration stored for the serial of each sensor into its conversion         *
+// **********************************************************************************************************
+static void task_calibrate(void)
+{
+    // Variable(s) declaration
+    sht4x_calibration_t calibration;
+    uint32_t temperature;
+    uint32_t humidity;
+    uint32_t serial;
+    uint32_t key;
+    uint8_t sensor;
+    uint8_t slot;
+
+    // Nothing to load when the calibration is left out of the build
+    for (sensor = 0u; (SHT4X_CALIBRATION_ENABLED != 0u) && (sensor < FUSION_SENSOR_COUNT); sensor++)
+    {
+        if ((g_sensors & (1u << sensor)) != 0u)
+        {
+            // Datasheet conversion, unless a slot holds the serial of the sensor
+            temperature = CONFIG_CALIBRATION_NONE;
+            humidity = CONFIG_CALIBRATION_NONE;
+            serial = sht4x_get_cached_serial_number(g_sht4x_handles[sensor]);
+            for (slot = 0u; slot < CONFIG_CALIBRATION_SLOTS; slot++)
+            {
+                key = CONFIG_KEY_CALIBRATION_SERIAL_0 + (slot * CONFIG_CALIBRATION_KEYS);
+                if ((serial != 0u) && (CONFIG_GET(key) == serial))
+                {
+                    temperature = CONFIG_GET(key + 1u);
+                    humidity = CONFIG_GET(key + 2u);
+                }
+            }
+
+            // Fold it into the conversion constants of the sensor
+            calibration.temperature_gain = CONFIG_CALIBRATION_GAIN(temperature);
+            calibration.temperature_offset = CONFIG_CALIBRATION_OFFSET(temperature);
+            calibration.humidity_gain = CONFIG_CALIBRATION_GAIN(humidity);
+            calibration.humidity_offset = CONFIG_CALIBRATION_OFFSET(humidity);
+            sht4x_set_calibration(g_sht4x_handles[sensor], &calibration);
+        }
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : task_check_identity                                                                   *
+// Description      : Read again the serial of the sensors which answer after a failure, and of one sensor  *
+//                    in turn periodically, to detect a replaced probe before its sample is converted       *
+// **********************************************************************************************************
+static void task_check_identity(uint8_t i_sensors)
+{
+    // Variable(s) declaration
+    uint32_t previous;
+    uint32_t serial;
+    uint8_t checked;
+    uint8_t changed;
+    uint8_t sensor;
+
+    // Variable(s) initialization
+    changed = 0u;
+
+    // A sensor which answers again may be another probe, a swap between two cycles is caught by the periodic
+    // check. The presence itself is checked by every measurement
+    checked = i_sensors & (uint8_t) ~g_sensors_valid;
+    if (++g_identity_counter >= TASK_IDENTITY_PERIOD)
+    {
+        g_identity_counter = 0u;
+        do
+        {
+            g_identity_next = (uint8_t) ((g_identity_next + 1u) % FUSION_SENSOR_COUNT);
+        } while ((g_sensors & (1u << g_identity_next)) == 0u);
+        checked |= i_sensors & (uint8_t) (1u << g_identity_next);
+    }
+
+    // Read the serials, a failed read keeps the known serial until the next check
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((checked & (1u << sensor)) != 0u)
+        {
+            previous = sht4x_get_cached_serial_number(g_sht4x_handles[sensor]);
+            if ((sht4x_get_serial_number(g_sht4x_handles[sensor], &serial) == STATUS_OK) &&
+                (serial != previous))
+            {
+                changed |= (uint8_t) (1u << sensor);
+            }
+        }
+    }
+
+    if (changed != 0u)
+    {
+        // New identity: load the calibration of the new probe, and stamp its samples with a new generation
+        task_calibrate();
+        g_identity_generation++;
+        for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+        {
+            if ((changed & (1u << sensor)) != 0u)
+            {
+                task_send_identity(sensor);
+            }
+        }
+
+        // The history of the old probe ends here: no rate across the swap, close the statistics window
+        alarm_missed();
+        if ((STATS_ENABLED != 0u) && (g_stats_temperature.count != 0u) && (g_summary_pending == FALSE))
+        {
+            task_send_summary();
+        }
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : task_recover                                                                          *
+// Description      : Backoff and recovery action before a new measurement attempt                          *
+// **********************************************************************************************************
+static void task_recover(uint8_t i_failures)
+{
+    // Variable(s) declaration
+    uint8_t sensor;
+
+    // Record the recovery step
+    TRACE_EVENT(TRACE_EVENT_I2C_RECOVER, i_failures);
+
+    // Exponential backoff: 1, 2 then 4 ms
+    delay_function(1u << (i_failures - 1u));
+
+    // From the second failure: free the bus, a slave may hold SDA low
+    if ((TEMP_HUM_SENSOR_CLEAR_ENABLED != 0u) && (i_failures >= 2u))
+    {
+        hw_i2c_recover();
+    }
+
+    // From the third failure: restart the sensors as well
+    if (i_failures >= 3u)
+    {
+        for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+        {
+            if ((g_sensors & (1u << sensor)) != 0u)
+            {
+                sht4x_soft_reset(g_sht4x_handles[sensor]);
+            }
+        }
+        delay_function(TASK_SOFT_RESET_DELAY_MS);
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_sensor_error                                                                *
+// Description      : Send the sensor error frame of a cycle without measurement                            *
+// **********************************************************************************************************
+static void task_send_sensor_error(status_e i_status, uint8_t i_attempts)
+{
+    // Variable(s) declaration
+    uint8_t payload[3];
+
+    // Status of the last attempt, number of attempts and error code of the last failed transfer
+    payload[0] = (uint8_t) i_status;
+    payload[1] = i_attempts;
+    payload[2] = g_i2c_error;
+
+    // Send the frame
+    com_send_frame(COM_FRAME_SENSOR_ERROR, payload, sizeof(payload));
+}
+
+// **********************************************************************************************************
+// Function name    : task_elapsed_us                                                                       *
+// Description      : Time elapsed since a start point, precise to the microsecond for short durations      *
+// **********************************************************************************************************
+static uint32_t task_elapsed_us(uint32_t i_start_tick, uint16_t i_start_ts)
+{
+    // Variable(s) declaration
+    uint32_t r_elapsed;
+
+    // The 16 bits timestamp timer wraps every 65 ms, use the SysTick for longer durations
+    r_elapsed = HAL_GetTick() - i_start_tick;
+    if (r_elapsed < 60u)
+    {
+        r_elapsed = (uint16_t) (HW_TIMESTAMP_GET() - i_start_ts);
+    }
+    else
+    {
+        r_elapsed *= 1000u;
+    }
+
+    // Return the elapsed time
+    return r_elapsed;
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_heartbeat                                                                   *
+// Description      : Send the heartbeat frame with the energy estimate                                     *
+// **********************************************************************************************************
+static void task_send_heartbeat(void)
+{
+    // Variable(s) declaration
+    energy_report_t report;
+    uint8_t payload[TASK_HEARTBEAT_SIZE];
+    uint8_t* p_data;
+
+    // Serialize the energy report
+    energy_get_report(&report);
+    p_data = com_put_u32(payload, report.battery_life_h);
+    p_data = com_put_u32(p_data, report.average_ua);
+    com_put_u32(p_data, report.consumed_uah);
+
+    // Send the frame
+    com_send_frame(COM_FRAME_HEARTBEAT, payload, sizeof(payload));
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_measurement                                                                 *
+// Description      : Send the pending sample to the station                                                *
+// **********************************************************************************************************
+static void task_send_measurement(void)
+{
+    // Variable(s) declaration
+    uint8_t message[TASK_MESSAGE_SIZE];
+    uint8_t* p_data;
+    int32_t temperatures[FUSION_SENSOR_COUNT];
+    int32_t humidities[FUSION_SENSOR_COUNT];
+    int32_t temperature;
+    int32_t humidity;
+    uint32_t format;
+    status_e status;
+
+    // Variable(s) initialization
+    format = (TASK_FORMATS_ENABLED != 0u) ? CONFIG_GET(CONFIG_KEY_FORMAT) : TASK_FORMAT_STANDARD;
+
+    // The standard sample is already fused, the other formats are fused again from the same sensors
+    if (format == TASK_FORMAT_STANDARD)
+    {
+        temperature = g_temperature;
+        humidity = g_humidity;
+    }
+    else
+    {
+        task_convert((task_format_e) format, g_sensors_used, temperatures, humidities);
+        temperature = fusion_mean(temperatures, g_sensors_used);
+        humidity = fusion_mean(humidities, g_sensors_used);
+    }
+
+    // Raw words only (not calibrated), the station converts them
+    if (format == TASK_FORMAT_RAW)
+    {
+        p_data = com_put_u16(message, (uint16_t) temperature);
+        p_data = com_put_u16(p_data, (uint16_t) humidity);
+        *p_data++ = g_attempts;
+        *p_data++ = g_identity_generation;
+        com_put_u32(p_data, g_timestamp);
+        status = com_send_frame(COM_FRAME_MEASUREMENT_RAW, message, TASK_MESSAGE_RAW_SIZE);
+        TRACE_EVENT(TRACE_EVENT_UART_TX, status);
+    }
+    else
+    {
+        // Fill the message for the UART
+        p_data = com_put_u16(message, (uint16_t) temperature);
+        p_data = com_put_u16(p_data, (uint16_t) humidity);
+        *p_data++ = g_attempts;
+
+        // Add the derived values, computed here as the frame is sent during the conversion. Each kernel is
+        // profiled on its own
+        PROF_START(PROF_PHASE_DEW_POINT);
+        p_data = com_put_u16(p_data, (uint16_t) psychro_dew_point(g_temperature, g_humidity));
+        PROF_STOP(PROF_PHASE_DEW_POINT);
+        PROF_START(PROF_PHASE_ABSOLUTE_HUMIDITY);
+        p_data = com_put_u16(p_data, psychro_absolute_humidity(g_temperature, g_humidity));
+        PROF_STOP(PROF_PHASE_ABSOLUTE_HUMIDITY);
+        PROF_START(PROF_PHASE_HEAT_INDEX);
+        p_data = com_put_u16(p_data, (uint16_t) psychro_heat_index(g_temperature, g_humidity));
+        PROF_STOP(PROF_PHASE_HEAT_INDEX);
+
+        // The sensors which gave the sample and the time it was taken
+        *p_data++ = g_identity_generation;
+        com_put_u32(p_data, g_timestamp);
+
+        // Send it, the frame type gives the resolution of the sample
+        status = com_send_frame((format == TASK_FORMAT_STANDARD) ?
+                                COM_FRAME_MEASUREMENT : COM_FRAME_MEASUREMENT_FINE,
+                                message, TASK_MESSAGE_SIZE);
+        TRACE_EVENT(TRACE_EVENT_UART_TX, status);
+    }
+
+    // The station acknowledges it before the next cycle
+    g_sent_temperature = g_temperature;
+    g_sent_humidity = g_humidity;
+    g_sent_timestamp = g_timestamp;
+    g_sent_waiting_ack = TRUE;
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_boot                                                                        *
+// Description      : Send the boot frame with the latency from HAL_Init to the end of the first            *
+//                    measurement, successful or not, and the reset cause                                   *
+// **********************************************************************************************************
+static void task_send_boot(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[5];
+    uint8_t* p_data;
+    uint32_t latency;
+    uint8_t sensor;
+
+    // Milliseconds since HAL_Init started the SysTick, plus the part of the current millisecond. The startup
+    // code before HAL_Init (data and bss initialization at 8 MHz, a few tens of microseconds) is not counted
+    latency = (HAL_GetTick() * 1000u) + ((SysTick->LOAD - SysTick->VAL) / HW_SYSCLK_MHZ);
+
+    // Send the frame
+    p_data = com_put_u32(payload, latency);
+    *p_data = ge_hw_reset_cause;
+    com_send_frame(COM_FRAME_BOOT, payload, sizeof(payload));
+
+    // And the serial of the sensors
+    for (sensor = 0u; (TASK_IDENTITY_ENABLED != 0u) && (sensor < FUSION_SENSOR_COUNT); sensor++)
+    {
+        if ((g_sensors & (1u << sensor)) != 0u)
+        {
+            task_send_identity(sensor);
+        }
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_summary                                                                     *
+// Description      : Send the statistics of the last window to the station and start a new window          *
+// **********************************************************************************************************
+static void task_send_summary(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[TASK_SUMMARY_SIZE];
+    uint8_t* p_data;
+    status_e status;
+
+    // Count, then minimum and maximum in 0.1 unit, mean and standard deviation in 0.01 unit
+    p_data = com_put_u16(payload, g_stats_temperature.count);
+    p_data = com_put_u16(p_data, (uint16_t) g_stats_temperature.min);
+    p_data = com_put_u16(p_data, (uint16_t) g_stats_temperature.max);
+    p_data = com_put_u16(p_data, (uint16_t) stats_mean(&g_stats_temperature));
+    p_data = com_put_u16(p_data, (uint16_t) stats_stddev(&g_stats_temperature));
+    p_data = com_put_u16(p_data, (uint16_t) g_stats_humidity.min);
+    p_data = com_put_u16(p_data, (uint16_t) g_stats_humidity.max);
+    p_data = com_put_u16(p_data, (uint16_t) stats_mean(&g_stats_humidity));
+    com_put_u16(p_data, (uint16_t) stats_stddev(&g_stats_humidity));
+
+    // Send the frame
+    status = com_send_frame(COM_FRAME_STATS, payload, sizeof(payload));
+    TRACE_EVENT(TRACE_EVENT_UART_TX, status);
+
+    // Start a new window
+    stats_reset(&g_stats_temperature);
+    stats_reset(&g_stats_humidity);
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_alarm                                                                       *
+// Description      : Send the alarm state to the station right away                                        *
+// **********************************************************************************************************
+static void task_send_alarm(uint8_t i_changed)
+{
+    // Variable(s) declaration
+    uint8_t payload[TASK_ALARM_SIZE];
+    uint8_t* p_data;
+    status_e status;
+
+    // Active and changed flags, then the sample which changed them
+    payload[0] = alarm_get_active();
+    payload[1] = i_changed;
+    p_data = com_put_u16(&payload[2], (uint16_t) g_temperature);
+    com_put_u16(p_data, g_humidity);
+
+    // Send the frame
+    status = com_send_frame(COM_FRAME_ALARM, payload, sizeof(payload));
+    TRACE_EVENT(TRACE_EVENT_UART_TX, status);
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_fusion                                                                      *
+// Description      : Send the state of the fused sensors to the station                                    *
+// **********************************************************************************************************
+static void task_send_fusion(void)
+{
+    // Variable(s) declaration
+    uint8_t payload[TASK_FUSION_SIZE];
+    status_e status;
+
+    // Fitted sensors, sensors which answered and sensors left out of the fused sample (bit n for address n)
+    payload[0] = g_sensors;
+    payload[1] = g_sensors_valid;
+    payload[2] = g_sensors_outliers;
+
+    // Send the frame
+    status = com_send_frame(COM_FRAME_FUSION, payload, sizeof(payload));
+    TRACE_EVENT(TRACE_EVENT_UART_TX, status);
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_identity                                                                    *
+// Description      : Send the serial number of a sensor to the station                                     *
+// **********************************************************************************************************
+static void task_send_identity(uint8_t i_sensor)
+{
+    // Variable(s) declaration
+    uint8_t payload[TASK_IDENTITY_SIZE];
+    status_e status;
+
+    // Address, generation stamped into the next measurement frames and serial (0 if it could not be read)
+    payload[0] = i_sensor;
+    payload[1] = g_identity_generation;
+    com_put_u32(&payload[2], sht4x_get_cached_serial_number(g_sht4x_handles[i_sensor]));
+
+    // Send the frame
+    status = com_send_frame(COM_FRAME_IDENTITY, payload, sizeof(payload));
+    TRACE_EVENT(TRACE_EVENT_UART_TX, status);
+}
+
+// **********************************************************************************************************
+// Function name    : task_check_quality                                                                    *
+// Description      : Leave the stuck and spiking samples out of the fused sample                           *
+// **********************************************************************************************************
+static uint8_t task_check_quality(uint8_t i_sensors, const int32_t* i_p_temperatures,
+                                  const int32_t* i_p_humidities)
+{
+    // Variable(s) declaration
+    uint8_t changed;
+    uint8_t sensor;
+    uint8_t r_accepted;
+
+    // Variable(s) initialization
+    r_accepted = 0u;
+
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((i_sensors & (1u << sensor)) == 0u)
+        {
+            // No sample: the slew is not checked across the gap
+            quality_missed(sensor);
+        }
+        else if (heater_is_settling() == TRUE)
+        {
+            // The heating moves the sample faster than the air does: restart the slew check after it
+            quality_missed(sensor);
+            r_accepted |= (uint8_t) (1u << sensor);
+        }
+        else if (quality_check(sensor, g_raw_temperatures[sensor], g_raw_humidities[sensor],
+                               i_p_temperatures[sensor], i_p_humidities[sensor]) == TRUE)
+        {
+            r_accepted |= (uint8_t) (1u << sensor);
+        }
+    }
+
+    // Report the sensors whose flags were raised or cleared, including by the reads of a failed cycle
+    changed = quality_get_changed();
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if ((changed & (1u << sensor)) != 0u)
+        {
+            task_send_quality(sensor);
+        }
+    }
+
+    // Return the sensors which can be used
+    return r_accepted;
+}
+
+// **********************************************************************************************************
+// Function name    : task_send_quality                                                                     *
+// Description      : Send the quality flags and counters of a sensor to the station                        *
+// **********************************************************************************************************
+static void task_send_quality(uint8_t i_sensor)
+{
+    // Variable(s) declaration
+    const quality_counters_t* p_counters;
+    uint8_t payload[TASK_QUALITY_SIZE];
+    uint8_t* p_data;
+    status_e status;
+
+    // Variable(s) initialization
+    p_counters = quality_get_counters(i_sensor);
+
+    // Address, flags and saturated counters
+    payload[0] = i_sensor;
+    payload[1] = quality_get_flags(i_sensor);
+    p_data = com_put_u16(&payload[2], p_counters->stuck);
+    p_data = com_put_u16(p_data, p_counters->spikes);
+    com_put_u16(p_data, p_counters->crc_errors);
+
+    // Send the frame
+    status = com_send_frame(COM_FRAME_QUALITY, payload, sizeof(payload));
+    TRACE_EVENT(TRACE_EVENT_UART_TX, status);
+}
+
+// **********************************************************************************************************
+// Function name    : task_heat                                                                             *
+// Description      : Fire a heater pulse with the MCU asleep during the heating                            *
+// **********************************************************************************************************
+static void task_heat(const heater_pulse_t* i_p_pulse)
+{
+    // Variable(s) declaration
+    uint16_t raw_temperature;
+    uint16_t raw_humidity;
+    uint8_t heated;
+    uint8_t sensor;
+
+    // Variable(s) initialization
+    heated = 0u;
+
+    // Start the pulse on every sensor, they all see the same humidity
+    TRACE_EVENT(TRACE_EVENT_HEATER, i_p_pulse->duration);
+    for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+    {
+        if (((g_sensors & (1u << sensor)) != 0u) &&
+            (sht4x_start_heater(g_sht4x_handles[sensor], i_p_pulse->power, i_p_pulse->duration) == STATUS_OK))
+        {
+            heated |= (uint8_t) (1u << sensor);
+        }
+    }
+
+    if (heated != 0u)
+    {
+        // Sleep until the sensors have measured at the end of the pulse (up to 1.01 s)
+        hw_sleep_ms((uint16_t) sht4x_get_heater_time(i_p_pulse->duration));
+
+        // The measurements taken at the end of the heating are distorted: fetch them to free the sensors only
+        for (sensor = 0u; sensor < FUSION_SENSOR_COUNT; sensor++)
+        {
+            if ((heated & (1u << sensor)) != 0u)
+            {
+                energy_add(ENERGY_STATE_HEATER, i_p_pulse->on_time_us);
+                sht4x_read_measurement_raw(g_sht4x_handles[sensor], &raw_temperature, &raw_humidity);
+            }
+        }
+
+        // Start the settling time and spend the duty cycle budget
+        heater_fired(i_p_pulse);
+        DIAG_COUNT(DIAG_COUNTER_HEATER_PULSES);
+    }
+}
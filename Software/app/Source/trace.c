@@ -0,0 +1,91 @@
+// **********************************************************************************************************
+// File name         : trace.c                                                                              *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Binary event trace ring buffer, usable from interrupts and driver paths              *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "trace.h"
+#include "com.h"
+#include "main.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Record of the ring (8 bytes, little endian when dumped)
+typedef struct
+{
+    uint32_t tick_ms;
+    uint16_t time_us;
+    uint8_t event;
+    uint8_t arg;
+} trace_record_t;
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Mask of the recorded events
+volatile uint32_t ge_trace_mask = TRACE_DEFAULT_MASK;
+
+#if TRACE_ENABLED
+// Ring buffer, only the records written since the boot are read
+static NOINIT trace_record_t g_trace_ring[TRACE_SIZE];
+static uint32_t g_trace_head;
+
+// **********************************************************************************************************
+//                                           Public fuctions                                                *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : trace_write                                                                           *
+// Description      : Write a record in the ring, the oldest record is overwritten when it is full.         *
+// **********************************************************************************************************
+void trace_write(trace_event_e i_event, uint8_t i_arg)
+{
+    // Variable(s) declaration
+    trace_record_t* p_record;
+    uint32_t primask;
+
+    // The Cortex-M0 has no exclusive access: mask the interrupts for the few stores of the record
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    // Take the next slot and fill it
+    p_record = &g_trace_ring[g_trace_head & (TRACE_SIZE - 1u)];
+    g_trace_head++;
+    p_record->tick_ms = HAL_GetTick();
+    p_record->time_us = HW_TIMESTAMP_GET();
+    p_record->event = (uint8_t) i_event;
+    p_record->arg = i_arg;
+
+    // Restore the interrupts
+    __set_PRIMASK(primask);
+}
+
+// **********************************************************************************************************
+// Function name    : trace_dump                                                                            *
+// Description      : Send the records of the ring, oldest first, in a trace frame.                         *
+// **********************************************************************************************************
+void trace_dump(void)
+{
+    // Variable(s) declaration
+    trace_record_t records[TRACE_SIZE];
+    uint32_t head;
+    uint32_t count;
+    uint32_t index;
+
+    // Take a consistent copy of the ring
+    __disable_irq();
+    head = g_trace_head;
+    count = (head < TRACE_SIZE) ? head : TRACE_SIZE;
+    for (index = 0u ; index < count ; index++)
+    {
+        records[index] = g_trace_ring[(head - count + index) & (TRACE_SIZE - 1u)];
+    }
+    __enable_irq();
+
+    // Send the records
+    com_send_frame(COM_FRAME_TRACE, (uint8_t*) records, (uint8_t) (count * sizeof(trace_record_t)));
+}
+#endif
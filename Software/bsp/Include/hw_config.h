@@ -31,38 +31,153 @@
 #define COM_UART_RX_PIN                         GPIO_PIN_3
 #define COM_UART_RX_PORT                        GPIOA
 
+// ********************************************** RCC *******************************************************
+#define HW_SYSCLK_MHZ                           (48u)
+
 // ********************************************* TIMER ******************************************************
 #define TIM                                     TIM1
+
+// Default wakeup period, the runtime value comes from the configuration store
 #define TIM_PRESCALER                           (59999u)
 #define TIM_PERIOD                              (40000u)
 
+// Free-running timestamp timer (1 MHz, 16 bits)
+#define TS_TIM                                  TIM14
+#define TS_TIM_PRESCALER                        (47u)
+#define TS_TIM_PERIOD                           (0xFFFFu)
+#define HW_TIMESTAMP_GET()                      ((uint16_t) TS_TIM->CNT)
+
+// One-shot sleep timer (1 kHz, 16 bits)
+#define SLEEP_TIM                               TIM16
+#define SLEEP_TIM_PRESCALER                     (47999u)
+
+// ******************************************* WATCHDOG *****************************************************
+// Independent watchdog on the LSI (40 kHz nominal, 30 to 50 kHz): prescaler 256 (PR = 6), reload 4095
+// The timeout is 20.9 s at 50 kHz and 34.9 s at 30 kHz
+#define HW_WDG_PRESCALER                        (IWDG_PR_PR_2 | IWDG_PR_PR_1)
+#define HW_WDG_RELOAD                           (0x0FFFu)
+#define HW_WDG_REFRESH()                        (IWDG->KR = 0xAAAAu)
+
+// Longest interval between two refreshes: the shortest timeout minus a margin for the task itself
+#define HW_WDG_REFRESH_MAX_US                   (17000000u)
+
+// Resets keeping the RAM content (watchdog or software reset without power-on reset)
+#define HW_RESET_IS_WARM()                      (((ge_hw_reset_cause & (HW_RESET_IWDG | HW_RESET_SOFTWARE)) != 0u) && \
+                                                 ((ge_hw_reset_cause & HW_RESET_POWER_ON) == 0u))
+
+// Reset cause flags (RCC_CSR bits 24 to 31)
+#define HW_RESET_OPTION_BYTES                   ((uint8_t) (RCC_CSR_OBLRSTF >> 24u))
+#define HW_RESET_PIN                            ((uint8_t) (RCC_CSR_PINRSTF >> 24u))
+#define HW_RESET_POWER_ON                       ((uint8_t) (RCC_CSR_PORRSTF >> 24u))
+#define HW_RESET_SOFTWARE                       ((uint8_t) (RCC_CSR_SFTRSTF >> 24u))
+#define HW_RESET_IWDG                           ((uint8_t) (RCC_CSR_IWDGRSTF >> 24u))
+#define HW_RESET_WWDG                           ((uint8_t) (RCC_CSR_WWDGRSTF >> 24u))
+#define HW_RESET_LOW_POWER                      ((uint8_t) (RCC_CSR_LPWRRSTF >> 24u))
+
 // ********************************************** I2C *******************************************************
 // Temperature and humidity sensor
 #define TEMP_HUM_SENSOR                         I2C1
-#define TEMP_HUM_SENSOR_TIMING                  (0x00201D2B)
+// Default bus speed, the runtime value comes from the configuration store. A stored timing register value
+// replaces the timing computed from the speed
+#define TEMP_HUM_SENSOR_SPEED_HZ                (100000u)
+#define TEMP_HUM_SENSOR_SPEED_MIN_HZ            (10000u)
+#define TEMP_HUM_SENSOR_SPEED_MAX_HZ            (1000000u)
+#define TEMP_HUM_SENSOR_TIMING_COMPUTED         (0u)
+
+// Set to 1 to add the computation of the timing for any bus speed to the build, the speed only selects the
+// mode otherwise and the bus runs at its nominal speed (100 kHz, 400 kHz or 1 MHz)
+#ifndef TEMP_HUM_SENSOR_TIMING_ENABLED
+#define TEMP_HUM_SENSOR_TIMING_ENABLED          (0u)
+#endif
+
+// Kernel clock: HSI up to Fast-mode, SYSCLK above (tI2CCLK must stay below a quarter of the low period)
+#define TEMP_HUM_SENSOR_CLOCK_HSI_HZ            (8000000u)
+#define TEMP_HUM_SENSOR_CLOCK_SYSCLK_HZ         (HW_SYSCLK_MHZ * 1000000u)
+#define TEMP_HUM_SENSOR_FAST_MAX_HZ             (400000u)
+
+// Bus rise and fall times with the board pull-ups, minimum delay of the analog filter (the digital filter
+// is off)
+#define TEMP_HUM_SENSOR_RISE_NS                 (100u)
+#define TEMP_HUM_SENSOR_FALL_NS                 (10u)
+#define TEMP_HUM_SENSOR_FILTER_NS               (50u)
+
+// Set to 1 to add the bus clear to the recovery of the sensor transfers, the recovery only retries and
+// restarts the sensors otherwise
+#ifndef TEMP_HUM_SENSOR_CLEAR_ENABLED
+#define TEMP_HUM_SENSOR_CLEAR_ENABLED           (0u)
+#endif
+
+// Bus clear: SCL pulses to make a slave release SDA, half period of the pulses
+#define TEMP_HUM_SENSOR_CLEAR_PULSES            (9u)
+#define TEMP_HUM_SENSOR_HALF_PERIOD_US          (500000u / TEMP_HUM_SENSOR_SPEED_HZ)
+
+// Error flags of the last failed transfer (same values as the HAL error codes)
+#define HW_I2C_ERROR_NONE                       (0x00u)
+#define HW_I2C_ERROR_BUS                        (0x01u)
+#define HW_I2C_ERROR_ARBITRATION                (0x02u)
+#define HW_I2C_ERROR_NACK                       (0x04u)
+#define HW_I2C_ERROR_TIMEOUT                    (0x20u)
 
 // ********************************************** UART ******************************************************
 // Communication UART
 #define COMMUNICATION_UART                      USART1
+// Default baudrate, the runtime value comes from the configuration store. It is also the safe rate the link
+// falls back to
 #define COMMUNICATION_UART_BAUDRATE             (9600u)
 
+// Kernel clock (PCLK) and accepted baudrates, the rate error must stay within 2 % with 16 times oversampling
+#define COMMUNICATION_UART_CLOCK_HZ             (HW_SYSCLK_MHZ * 1000000u)
+#define COMMUNICATION_UART_BAUDRATE_MIN         (1200u)
+#define COMMUNICATION_UART_BAUDRATE_MAX         (921600u)
+#define COMMUNICATION_UART_ERROR_DIVIDER        (50u)
+
 // ******************************************* INTERRUPT ****************************************************
 // Timer interrupt
 #define TIM_IT_IRQ                              TIM1_BRK_UP_TRG_COM_IRQn
 #define TIM_IT_IRQ_HANDLER                      TIM1_BRK_UP_TRG_COM_IRQHandler
-#define TIM_UP_CALLBACK                         HAL_TIM_PeriodElapsedCallback
+
+// Sleep timer interrupt
+#define SLEEP_TIM_IRQ                           TIM16_IRQn
+#define SLEEP_TIM_IRQ_HANDLER                   TIM16_IRQHandler
+
+// Communication UART interrupt
+#define COMMUNICATION_UART_IRQ                  USART1_IRQn
+#define COMMUNICATION_UART_IRQ_HANDLER          USART1_IRQHandler
 
 // **********************************************************************************************************
 //                                           Public variables                                               *
 // **********************************************************************************************************
-// Global hw handle(s)
-extern I2C_HandleTypeDef ge_hw_i2c_handle;
-extern UART_HandleTypeDef ge_hw_uart_handle;
-extern TIM_HandleTypeDef ge_hw_tim_handle;
+// Baudrate of the communication UART
+extern uint32_t ge_hw_uart_baudrate;
+
+// Error flags of the last failed sensor transfer (HW_I2C_ERROR_* flags)
+extern uint8_t ge_hw_i2c_error;
+
+// Cause of the last reset (HW_RESET_* flags)
+extern uint8_t ge_hw_reset_cause;
+
+// Number of timer periods per measurement cycle, the cycle is sliced to refresh the watchdog in time
+extern uint32_t ge_hw_tim_slices;
+
+// Timer periods elapsed in the current measurement cycle (negative when the cycle is lengthened)
+extern volatile int32_t ge_hw_tim_slice;
+
+// Timer periods elapsed since the timer start and ticks removed from the count by the phase changes, base of
+// the device clock
+extern volatile uint32_t ge_hw_tim_periods;
+extern volatile int32_t ge_hw_tim_shift;
 
 // **********************************************************************************************************
 //                                            Public fuctions                                               *
 // **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : hw_early_config                                                                       *
+// Description      : Latch the reset cause and start the watchdog, called before anything else.            *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void hw_early_config(void);
+
 // **********************************************************************************************************
 // Function name	: hw_config                                                                             *
 // Description		: Hardware configuration function.                                                      *
@@ -71,4 +186,96 @@ extern TIM_HandleTypeDef ge_hw_tim_handle;
 // **********************************************************************************************************
 void hw_config(void);
 
+// **********************************************************************************************************
+// Function name    : hw_tim_start                                                                          *
+// Description      : Start the wakeup timer and its update interrupt.                                      *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void hw_tim_start(void);
+
+// **********************************************************************************************************
+// Function name    : hw_i2c_transfer                                                                       *
+// Description      : Write or read a sensor in a single transfer, ended by a STOP. A failed transfer        *
+//                    resets the peripheral and its error flags are kept in ge_hw_i2c_error.                *
+// Argument         : (uint8_t) i_address: 7 bits slave address                                             *
+//                  : (uint8_t*) io_p_data: Data to write, or buffer for the data read                      *
+//                  : (size_t) i_size: Size of the data in bytes (1 to 255)                                 *
+//                  : (bool_e) i_read: TRUE to read, FALSE to write                                         *
+//                  : (uint32_t) i_timeout_ms: Timeout of the whole transfer, bus busy wait included        *
+// Return value     : (status_e) : STATUS_BUSY if the bus stays busy, STATUS_TIMEOUT, STATUS_ERROR on a     *
+//                    NACK, a bus error or a lost arbitration                                               *
+// **********************************************************************************************************
+status_e hw_i2c_transfer(uint8_t i_address, uint8_t* io_p_data, size_t i_size, bool_e i_read,
+                         uint32_t i_timeout_ms);
+
+// **********************************************************************************************************
+// Function name    : hw_i2c_recover                                                                        *
+// Description      : Free a stuck sensor bus with SCL pulses and a STOP, then reinitialize the I2C.        *
+// Argument         : None                                                                                  *
+// Return value     : (status_e) : STATUS_ERROR if SDA is still held low                                    *
+// **********************************************************************************************************
+status_e hw_i2c_recover(void);
+
+// **********************************************************************************************************
+// Function name    : hw_sleep_ms                                                                           *
+// Description      : Sleep until the one-shot timer expires, the other interrupts are served meanwhile.    *
+// Argument         : (uint16_t) i_delay_ms: Delay in milliseconds (the sleep lasts up to 1 ms longer)      *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void hw_sleep_ms(uint16_t i_delay_ms);
+
+// **********************************************************************************************************
+// Function name    : hw_tim_set_remaining                                                                  *
+// Description      : Move the phase of the wakeup timer: the next task request comes after the given time. *
+//                    The device clock is kept continuous.                                                  *
+// Argument         : (uint32_t) i_ticks: Timer ticks until the next task request (at least 1)              *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void hw_tim_set_remaining(uint32_t i_ticks);
+
+// **********************************************************************************************************
+// Function name    : hw_uart_check_baudrate                                                                *
+// Description      : Check whether the kernel clock gives a baudrate within the accepted error.            *
+// Argument         : (uint32_t) i_baudrate: Baudrate                                                       *
+// Return value     : (status_e) : STATUS_ERROR if the baudrate is out of range or too far from the clock   *
+// **********************************************************************************************************
+status_e hw_uart_check_baudrate(uint32_t i_baudrate);
+
+// **********************************************************************************************************
+// Function name    : hw_uart_set_baudrate                                                                  *
+// Description      : Change the baudrate of the communication UART, the transmission must be complete.     *
+//                    The automatic detection is stopped.                                                   *
+// Argument         : (uint32_t) i_baudrate: Baudrate                                                       *
+// Return value     : (status_e) : STATUS_ERROR if the clock cannot give the baudrate, which is unchanged   *
+// **********************************************************************************************************
+status_e hw_uart_set_baudrate(uint32_t i_baudrate);
+
+// **********************************************************************************************************
+// Function name    : hw_uart_autobaud                                                                      *
+// Description      : Measure the baudrate on the next received byte, which must start with the bits 1 then *
+//                    0 (as the start of frame 0xA5).                                                       *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+void hw_uart_autobaud(void);
+
+// **********************************************************************************************************
+// Function name    : hw_uart_autobaud_done                                                                 *
+// Description      : Check whether the automatic detection has measured the baudrate, and keep it.         *
+// Argument         : None                                                                                  *
+// Return value     : (bool_e) : TRUE if the baudrate has been measured                                     *
+// **********************************************************************************************************
+bool_e hw_uart_autobaud_done(void);
+
+// **********************************************************************************************************
+// Function name    : hw_uart_transmit                                                                      *
+// Description      : Send a buffer on the communication UART and wait for the end of the transmission.     *
+// Argument         : (const uint8_t*) i_p_data: Pointer to the data                                        *
+//                  : (size_t) i_size: Size of the data in bytes                                            *
+//                  : (uint32_t) i_timeout_ms: Timeout of the whole transmission                            *
+// Return value     : (status_e) : STATUS_TIMEOUT if the transmission did not complete in time              *
+// **********************************************************************************************************
+status_e hw_uart_transmit(const uint8_t* i_p_data, size_t i_size, uint32_t i_timeout_ms);
+
 # endif // _HW_CONFIG_H_
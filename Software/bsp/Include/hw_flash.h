@@ -0,0 +1,36 @@
+// **********************************************************************************************************
+// File name        : hw_flash.h                                                                            *
+// Author           : Richard I.                                                                            *
+// Date             : 18/10/2026                                                                            *
+// Description      : Internal flash erase and program helpers.                                             *
+// **********************************************************************************************************
+# ifndef _HW_FLASH_H_
+# define _HW_FLASH_H_
+
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "main.h"
+
+// **********************************************************************************************************
+//                                            Public fuctions                                               *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : hw_flash_erase_page                                                                   *
+// Description      : Erase a flash page.                                                                   *
+// Argument         : (uint32_t) i_address: Address of the page                                             *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+status_e hw_flash_erase_page(uint32_t i_address);
+
+// **********************************************************************************************************
+// Function name    : hw_flash_program                                                                      *
+// Description      : Program a buffer in erased flash, half-word by half-word.                             *
+// Argument         : (uint32_t) i_address: Destination address (half-word aligned)                         *
+//                  : (const void*) i_p_data: Pointer to the data (half-word aligned)                       *
+//                  : (size_t) i_size: Size of the data in bytes (even)                                     *
+// Return value     : (status_e) : Status of the operation                                                  *
+// **********************************************************************************************************
+status_e hw_flash_program(uint32_t i_address, const void* i_p_data, size_t i_size);
+
+# endif // _HW_FLASH_H_
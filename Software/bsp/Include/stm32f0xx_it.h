@@ -52,6 +52,7 @@ void SVC_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 void TIM_IT_IRQ_HANDLER(void);
+void COMMUNICATION_UART_IRQ_HANDLER(void);
 /* USER CODE BEGIN EFP */
 
 /* USER CODE END EFP */
@@ -8,18 +8,60 @@
 //                                               Include                                                    *
 // **********************************************************************************************************
 # include "hw_config.h"
+# include "config.h"
 
 // **********************************************************************************************************
 //                                               Defines                                                    *
 // **********************************************************************************************************
+// I2C specification limits of a bus mode (ns)
+typedef struct
+{
+    uint32_t speed_max_hz;
+    uint16_t low_min_ns;                        // tLOW
+    uint16_t high_min_ns;                       // tHIGH
+    uint16_t setup_min_ns;                      // tSU;DAT
+    uint32_t timing;                            // Reference manual timing at the nominal speed
+} hw_i2c_mode_t;
+
+// Timing register fields
+#define HW_I2C_PRESC_MAX                        (15u)
+#define HW_I2C_DEL_MAX                          (15u)
+#define HW_I2C_SCL_MAX                          (256u)
+
+// GPIO modes (MODER field)
+#define HW_GPIO_MODE_INPUT                      (0u)
+#define HW_GPIO_MODE_OUTPUT                     (1u)
+#define HW_GPIO_MODE_ALTERNATE                  (2u)
+
+// GPIO alternate functions of the UART and the I2C pins
+#define HW_GPIO_AF_USART1                       (1u)
+#define HW_GPIO_AF_I2C1                         (4u)
+
+// Bus modes and conversion of a time to kernel clock periods, rounded up (the kernel clocks are whole MHz)
+#define HW_I2C_MODE_COUNT                       (sizeof(g_hw_i2c_modes) / sizeof(g_hw_i2c_modes[0]))
+#define HW_I2C_CLOCKS(ns, clock_mhz)            ((((ns) * (clock_mhz)) + 999u) / 1000u)
 
 // **********************************************************************************************************   
 //                                              Variables                                                   *
 // **********************************************************************************************************
-// Global hw handle(s)
-I2C_HandleTypeDef ge_hw_i2c_handle;
-UART_HandleTypeDef ge_hw_uart_handle;
-TIM_HandleTypeDef ge_hw_tim_handle;
+// Baudrate of the communication UART, error flags of the last failed sensor transfer
+uint32_t ge_hw_uart_baudrate;
+uint8_t ge_hw_i2c_error;
+
+// Standard-mode and Fast-mode on the HSI, Fast-mode Plus on the SYSCLK
+static const hw_i2c_mode_t g_hw_i2c_modes[] =
+{
+    {100000u, 4700u, 4000u, 250u, 0x10420F13u},
+    {400000u, 1300u, 600u, 100u, 0x00310309u},
+    {1000000u, 500u, 260u, 50u, 0x50100103u},
+};
+
+// Reset cause, timer slicing, elapsed periods and phase changes
+uint8_t ge_hw_reset_cause;
+uint32_t ge_hw_tim_slices;
+volatile int32_t ge_hw_tim_slice;
+volatile uint32_t ge_hw_tim_periods;
+volatile int32_t ge_hw_tim_shift;
 
 // **********************************************************************************************************
 //                                       Private fuctions prototype                                         *
@@ -40,6 +82,27 @@ static void rcc_config(void);
 // **********************************************************************************************************
 static void gpio_config(void);
 
+// **********************************************************************************************************
+// Function name    : gpio_pin_config                                                                       *
+// Description      : Configure a pin, at high speed and without pull resistor.                             *
+// Argument         : (GPIO_TypeDef*) io_p_port: Port of the pin                                            *
+//                  : (uint16_t) i_pin: Pin (GPIO_PIN_x)                                                    *
+//                  : (uint32_t) i_mode: Mode (HW_GPIO_MODE_*)                                              *
+//                  : (bool_e) i_open_drain: TRUE for an open-drain output                                  *
+//                  : (uint32_t) i_alternate: Alternate function, used in the alternate mode only           *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void gpio_pin_config(GPIO_TypeDef* io_p_port, uint16_t i_pin, uint32_t i_mode, bool_e i_open_drain,
+                            uint32_t i_alternate);
+
+// **********************************************************************************************************
+// Function name    : i2c_gpio_config                                                                       *
+// Description      : Sensor I2C pins configuration function.                                               *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void i2c_gpio_config(void);
+
 // **********************************************************************************************************
 // Function name    : tim_config                                                                            *
 // Description      : Timer configuration function.                                                         *
@@ -48,6 +111,22 @@ static void gpio_config(void);
 // **********************************************************************************************************
 static void tim_config(void);
 
+// **********************************************************************************************************
+// Function name    : ts_tim_config                                                                         *
+// Description      : Timestamp timer configuration function.                                               *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void ts_tim_config(void);
+
+// **********************************************************************************************************
+// Function name    : sleep_tim_config                                                                      *
+// Description      : One-shot sleep timer configuration function.                                          *
+// Argument         : None                                                                                  *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sleep_tim_config(void);
+
 // **********************************************************************************************************
 // Function name    : i2c_config                                                                            *
 // Description      : I2C configuration function.                                                           *
@@ -56,6 +135,27 @@ static void tim_config(void);
 // **********************************************************************************************************
 static void i2c_config(void);
 
+// **********************************************************************************************************
+// Function name    : i2c_timing                                                                            *
+// Description      : Compute the I2C timing register for a bus speed, or take the one of its mode when the *
+//                    computation is left out of the build.                                                 *
+// Argument         : (uint32_t) i_clock_hz: I2C kernel clock                                               *
+//                  : (uint32_t) i_speed_hz: Bus speed, the bus may run slower to meet the mode limits      *
+// Return value     : (uint32_t) : Timing register value                                                    *
+// **********************************************************************************************************
+static uint32_t i2c_timing(uint32_t i_clock_hz, uint32_t i_speed_hz);
+
+// **********************************************************************************************************
+// Function name    : i2c_wait                                                                              *
+// Description      : Wait for a flag of the sensor I2C during a transfer.                                  *
+// Argument         : (uint32_t) i_flag: Awaited flag (I2C_ISR_*)                                           *
+//                  : (uint32_t) i_start_tick: SysTick value at the start of the transfer                   *
+//                  : (uint32_t) i_timeout_ms: Timeout of the transfer                                      *
+// Return value     : (status_e) : STATUS_ERROR on a NACK, a bus error or a lost arbitration,               *
+//                    STATUS_TIMEOUT when the transfer times out                                            *
+// **********************************************************************************************************
+static status_e i2c_wait(uint32_t i_flag, uint32_t i_start_tick, uint32_t i_timeout_ms);
+
 // **********************************************************************************************************
 // Function name    : uart_config                                                                           *
 // Description      : UART configuration function.                                                          *
@@ -72,9 +172,44 @@ static void uart_config(void);
 // **********************************************************************************************************
 static void nvic_config(void);
 
+// **********************************************************************************************************
+// Function name    : delay_us                                                                              *
+// Description      : Busy wait on the timestamp timer.                                                     *
+// Argument         : (uint16_t) i_delay_us: Delay in microseconds                                          *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void delay_us(uint16_t i_delay_us);
+
 // **********************************************************************************************************
 //                                            Public fuctions                                               *
 // **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : hw_early_config                                                                       *
+// Description      : Latch the reset cause and start the watchdog, called before anything else.            *
+// **********************************************************************************************************
+void hw_early_config(void)
+{
+    // Latch the reset cause then clear the flags for the next reset
+    ge_hw_reset_cause = (uint8_t) (RCC->CSR >> 24u);
+    RCC->CSR |= RCC_CSR_RMVF;
+
+    // Start the watchdog, the LSI is enabled by the hardware
+    IWDG->KR = 0xCCCCu;
+
+    // Unlock the registers and set the timeout
+    IWDG->KR = 0x5555u;
+    IWDG->PR = HW_WDG_PRESCALER;
+    IWDG->RLR = HW_WDG_RELOAD;
+    while (IWDG->SR != 0u)
+    {
+        // Wait for the registers to be updated in the LSI domain
+    }
+    HW_WDG_REFRESH();
+
+    // Freeze the watchdog in debug mode
+    __HAL_DBGMCU_FREEZE_IWDG();
+}
+
 // **********************************************************************************************************
 // Function name	: hw_config                                                                             *
 // Description		: Hardware configuration function.                                                      *
@@ -90,6 +225,12 @@ void hw_config(void)
     // Configure timer
     tim_config();
 
+    // Configure timestamp timer
+    ts_tim_config();
+
+    // Configure sleep timer
+    sleep_tim_config();
+
     // Configure I2C
     i2c_config();
 
@@ -100,6 +241,313 @@ void hw_config(void)
     nvic_config();
 }
 
+// **********************************************************************************************************
+// Function name    : hw_tim_start                                                                          *
+// Description      : Start the wakeup timer and its update interrupt.                                      *
+// **********************************************************************************************************
+void hw_tim_start(void)
+{
+    // Enable the update interrupt, then count
+    TIM->DIER = TIM_DIER_UIE;
+    TIM->CR1 |= TIM_CR1_CEN;
+}
+
+// **********************************************************************************************************
+// Function name    : hw_i2c_transfer                                                                       *
+// Description      : Write or read a sensor in a single transfer, ended by a STOP.                         *
+// **********************************************************************************************************
+status_e hw_i2c_transfer(uint8_t i_address, uint8_t* io_p_data, size_t i_size, bool_e i_read,
+                         uint32_t i_timeout_ms)
+{
+    // Variable(s) declaration
+    uint32_t start_tick;
+    status_e r_status;
+    size_t index;
+
+    // Variable(s) initialization
+    start_tick = HAL_GetTick();
+    r_status = STATUS_OK;
+
+    // Wait for the end of a transfer of another master, or for a slave to release the bus
+    while (((TEMP_HUM_SENSOR->ISR & I2C_ISR_BUSY) != 0u) && (r_status == STATUS_OK))
+    {
+        if ((HAL_GetTick() - start_tick) > i_timeout_ms)
+        {
+            ge_hw_i2c_error = HW_I2C_ERROR_TIMEOUT;
+            r_status = STATUS_BUSY;
+        }
+    }
+
+    if (r_status == STATUS_OK)
+    {
+        // Address and size, the STOP follows the last byte
+        TEMP_HUM_SENSOR->CR2 = ((uint32_t) i_address << 1u) | (i_size << I2C_CR2_NBYTES_Pos) |
+                               ((i_read == TRUE) ? I2C_CR2_RD_WRN : 0u) | I2C_CR2_AUTOEND | I2C_CR2_START;
+
+        // Move the bytes, then wait for the STOP
+        for (index = 0u ; (index < i_size) && (r_status == STATUS_OK) ; index++)
+        {
+            r_status = i2c_wait((i_read == TRUE) ? I2C_ISR_RXNE : I2C_ISR_TXIS, start_tick, i_timeout_ms);
+            if ((r_status == STATUS_OK) && (i_read == TRUE))
+            {
+                io_p_data[index] = (uint8_t) TEMP_HUM_SENSOR->RXDR;
+            }
+            else if (r_status == STATUS_OK)
+            {
+                TEMP_HUM_SENSOR->TXDR = io_p_data[index];
+            }
+        }
+        if (r_status == STATUS_OK)
+        {
+            r_status = i2c_wait(I2C_ISR_STOPF, start_tick, i_timeout_ms);
+        }
+        TEMP_HUM_SENSOR->ICR = I2C_ICR_STOPCF;
+    }
+
+    // Software reset after a failure: the flags are cleared, a pending byte is flushed and the lines released
+    if (r_status != STATUS_OK)
+    {
+        TEMP_HUM_SENSOR->CR1 &= ~I2C_CR1_PE;
+        while ((TEMP_HUM_SENSOR->CR1 & I2C_CR1_PE) != 0u)
+        {
+            // PE must stay low for 3 APB cycles, checking it is enough
+        }
+        TEMP_HUM_SENSOR->CR1 |= I2C_CR1_PE;
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : hw_i2c_recover                                                                        *
+// Description      : Free a stuck sensor bus with SCL pulses and a STOP, then reinitialize the I2C.        *
+// **********************************************************************************************************
+status_e hw_i2c_recover(void)
+{
+    // Variable(s) declaration
+    status_e r_status;
+    uint8_t pulse;
+
+    // Release the pins from the peripheral
+    TEMP_HUM_SENSOR->CR1 &= ~I2C_CR1_PE;
+
+    // SCL as an open-drain output released high, SDA as an input
+    TEMP_HUM_SCL_PORT->BSRR = TEMP_HUM_SCL_PIN;
+    gpio_pin_config(TEMP_HUM_SCL_PORT, TEMP_HUM_SCL_PIN, HW_GPIO_MODE_OUTPUT, TRUE, 0u);
+    gpio_pin_config(TEMP_HUM_SDA_PORT, TEMP_HUM_SDA_PIN, HW_GPIO_MODE_INPUT, FALSE, 0u);
+
+    // Clock the slave until it releases SDA (it completes the byte it was sending)
+    for (pulse = 0u ; (pulse < TEMP_HUM_SENSOR_CLEAR_PULSES) &&
+                      ((TEMP_HUM_SDA_PORT->IDR & TEMP_HUM_SDA_PIN) == 0u) ; pulse++)
+    {
+        TEMP_HUM_SCL_PORT->BRR = TEMP_HUM_SCL_PIN;
+        delay_us(TEMP_HUM_SENSOR_HALF_PERIOD_US);
+        TEMP_HUM_SCL_PORT->BSRR = TEMP_HUM_SCL_PIN;
+        delay_us(TEMP_HUM_SENSOR_HALF_PERIOD_US);
+    }
+    r_status = ((TEMP_HUM_SDA_PORT->IDR & TEMP_HUM_SDA_PIN) != 0u) ? STATUS_OK : STATUS_ERROR;
+
+    // Generate a STOP: SDA rises while SCL is high
+    TEMP_HUM_SCL_PORT->BRR = TEMP_HUM_SCL_PIN;
+    TEMP_HUM_SDA_PORT->BRR = TEMP_HUM_SDA_PIN;
+    gpio_pin_config(TEMP_HUM_SDA_PORT, TEMP_HUM_SDA_PIN, HW_GPIO_MODE_OUTPUT, TRUE, 0u);
+    delay_us(TEMP_HUM_SENSOR_HALF_PERIOD_US);
+    TEMP_HUM_SCL_PORT->BSRR = TEMP_HUM_SCL_PIN;
+    delay_us(TEMP_HUM_SENSOR_HALF_PERIOD_US);
+    TEMP_HUM_SDA_PORT->BSRR = TEMP_HUM_SDA_PIN;
+    delay_us(TEMP_HUM_SENSOR_HALF_PERIOD_US);
+
+    // Give the pins back to the peripheral and reinitialize it
+    i2c_gpio_config();
+    i2c_config();
+
+    // Return the status
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : hw_sleep_ms                                                                           *
+// Description      : Sleep until the one-shot timer expires, the other interrupts are served meanwhile.    *
+// **********************************************************************************************************
+void hw_sleep_ms(uint16_t i_delay_ms)
+{
+    // Start the timer, it stops by itself at the update event (CEN cleared)
+    SLEEP_TIM->ARR = (i_delay_ms != 0u) ? i_delay_ms : 1u;
+    SLEEP_TIM->CNT = 0u;
+    SLEEP_TIM->CR1 |= TIM_CR1_CEN;
+
+    // Sleep without SysTick, a wakeup from another interrupt goes back to sleep
+    HAL_SuspendTick();
+    while ((SLEEP_TIM->CR1 & TIM_CR1_CEN) != 0u)
+    {
+        __disable_irq();
+        if ((SLEEP_TIM->CR1 & TIM_CR1_CEN) != 0u)
+        {
+            __WFI();
+        }
+        __enable_irq();
+    }
+    HAL_ResumeTick();
+}
+
+// **********************************************************************************************************
+// Function name    : hw_tim_set_remaining                                                                  *
+// Description      : Move the phase of the wakeup timer: the next task request comes after the given time. *
+// **********************************************************************************************************
+void hw_tim_set_remaining(uint32_t i_ticks)
+{
+    // Variable(s) declaration
+    uint32_t period;
+    uint32_t updates;
+    uint32_t count;
+
+    // Periods to go, possibly more than a cycle, and count to start the current one from
+    period = TIM->ARR + 1u;
+    updates = (i_ticks + period - 1u) / period;
+    count = (updates * period) - i_ticks;
+
+    // Move the count and the slice together, the ticks skipped or repeated are kept out of the device clock.
+    // A pending update still counts one slice when its interrupt is served
+    __disable_irq();
+    ge_hw_tim_shift += (int32_t) TIM->CNT - (int32_t) count;
+    TIM->CNT = count;
+    ge_hw_tim_slice = (int32_t) ge_hw_tim_slices - (int32_t) updates;
+    if ((TIM->SR & TIM_SR_UIF) != 0u)
+    {
+        ge_hw_tim_slice--;
+    }
+    __enable_irq();
+}
+
+// **********************************************************************************************************
+// Function name    : hw_uart_check_baudrate                                                                *
+// Description      : Check whether the kernel clock gives a baudrate within the accepted error.            *
+// **********************************************************************************************************
+status_e hw_uart_check_baudrate(uint32_t i_baudrate)
+{
+    // Variable(s) declaration
+    uint32_t divider;
+    uint32_t error;
+
+    // Out of the supported range
+    if ((i_baudrate < COMMUNICATION_UART_BAUDRATE_MIN) || (i_baudrate > COMMUNICATION_UART_BAUDRATE_MAX))
+    {
+        return STATUS_ERROR;
+    }
+
+    // Nearest divider, refused when the rate it gives is too far from the requested one
+    divider = (COMMUNICATION_UART_CLOCK_HZ + (i_baudrate / 2u)) / i_baudrate;
+    error = ((divider * i_baudrate) > COMMUNICATION_UART_CLOCK_HZ) ?
+            ((divider * i_baudrate) - COMMUNICATION_UART_CLOCK_HZ) :
+            (COMMUNICATION_UART_CLOCK_HZ - (divider * i_baudrate));
+
+    // Return the status of the check
+    return ((divider >= 16u) && (divider <= 0xFFFFu) &&
+            ((error * COMMUNICATION_UART_ERROR_DIVIDER) <= (divider * i_baudrate))) ?
+           STATUS_OK : STATUS_ERROR;
+}
+
+// **********************************************************************************************************
+// Function name    : hw_uart_set_baudrate                                                                  *
+// Description      : Change the baudrate of the communication UART, the transmission must be complete.     *
+// **********************************************************************************************************
+status_e hw_uart_set_baudrate(uint32_t i_baudrate)
+{
+    // Variable(s) declaration
+    status_e r_status;
+
+    // Variable(s) initialization
+    r_status = hw_uart_check_baudrate(i_baudrate);
+
+    if (r_status == STATUS_OK)
+    {
+        // The divider and the detection can only be changed with the UART disabled
+        COMMUNICATION_UART->CR1 &= ~USART_CR1_UE;
+        COMMUNICATION_UART->CR2 &= ~USART_CR2_ABREN;
+        COMMUNICATION_UART->BRR = (COMMUNICATION_UART_CLOCK_HZ + (i_baudrate / 2u)) / i_baudrate;
+        COMMUNICATION_UART->CR1 |= USART_CR1_UE;
+        ge_hw_uart_baudrate = i_baudrate;
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : hw_uart_autobaud                                                                      *
+// Description      : Measure the baudrate on the next received byte.                                       *
+// **********************************************************************************************************
+void hw_uart_autobaud(void)
+{
+    if ((COMMUNICATION_UART->CR2 & USART_CR2_ABREN) == 0u)
+    {
+        // Falling edge to falling edge: the start bit and the first data bit are measured
+        COMMUNICATION_UART->CR1 &= ~USART_CR1_UE;
+        MODIFY_REG(COMMUNICATION_UART->CR2, USART_CR2_ABRMODE, USART_CR2_ABREN | USART_CR2_ABRMODE_0);
+        COMMUNICATION_UART->CR1 |= USART_CR1_UE;
+    }
+    else
+    {
+        // Already enabled: measure again
+        COMMUNICATION_UART->RQR = USART_RQR_ABRRQ;
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : hw_uart_autobaud_done                                                                 *
+// Description      : Check whether the automatic detection has measured the baudrate, and keep it.         *
+// **********************************************************************************************************
+bool_e hw_uart_autobaud_done(void)
+{
+    if (((COMMUNICATION_UART->CR2 & USART_CR2_ABREN) == 0u) ||
+        ((COMMUNICATION_UART->ISR & USART_ISR_ABRF) == 0u) ||
+        ((COMMUNICATION_UART->ISR & USART_ISR_ABRE) != 0u))
+    {
+        return FALSE;
+    }
+
+    // Keep the measured rate for the transmit time estimate
+    ge_hw_uart_baudrate = COMMUNICATION_UART_CLOCK_HZ / COMMUNICATION_UART->BRR;
+    return TRUE;
+}
+
+// **********************************************************************************************************
+// Function name    : hw_uart_transmit                                                                      *
+// Description      : Send a buffer on the communication UART and wait for the end of the transmission.     *
+// **********************************************************************************************************
+status_e hw_uart_transmit(const uint8_t* i_p_data, size_t i_size, uint32_t i_timeout_ms)
+{
+    // Variable(s) declaration
+    uint32_t start_tick;
+    status_e r_status;
+    size_t index;
+
+    // Variable(s) initialization
+    start_tick = HAL_GetTick();
+    r_status = STATUS_TIMEOUT;
+    index = 0u;
+
+    // Fill the transmit register as it empties, then wait for the last stop bit
+    while ((r_status == STATUS_TIMEOUT) && ((HAL_GetTick() - start_tick) <= i_timeout_ms))
+    {
+        if (index < i_size)
+        {
+            if ((COMMUNICATION_UART->ISR & USART_ISR_TXE) != 0u)
+            {
+                COMMUNICATION_UART->TDR = i_p_data[index++];
+            }
+        }
+        else if ((COMMUNICATION_UART->ISR & USART_ISR_TC) != 0u)
+        {
+            r_status = STATUS_OK;
+        }
+    }
+
+    // Return the status of the operation
+    return r_status;
+}
+
 // **********************************************************************************************************   
 //                                            Private fuctions                                              *
 // **********************************************************************************************************
@@ -109,48 +557,33 @@ void hw_config(void)
 // **********************************************************************************************************       
 static void rcc_config(void)
 {
-    // Variable(s) decaration
-    RCC_OscInitTypeDef rcc_init_struct = {0};
-    RCC_ClkInitTypeDef clk_init_struct = {0};
-    RCC_PeriphCLKInitTypeDef periph_init_struct = {0};
-
-    // Initialize the oscillator
-    rcc_init_struct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-    rcc_init_struct.HSIState = RCC_HSI_ON;
-    rcc_init_struct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-    rcc_init_struct.PLL.PLLState = RCC_PLL_ON;
-    rcc_init_struct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-    rcc_init_struct.PLL.PLLMUL = RCC_PLL_MUL12;
-    rcc_init_struct.PLL.PREDIV = RCC_PREDIV_DIV1;
-    if (HAL_OK != HAL_RCC_OscConfig(&rcc_init_struct))
+    // One wait state with the prefetch buffer before raising the clock
+    FLASH->ACR = FLASH_ACR_PRFTBE | FLASH_ACR_LATENCY;
+
+    // PLL on HSI / 2 times 12: 48 MHz. The loops are bounded by the watchdog, already running
+    RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_PLLSRC | RCC_CFGR_PLLMUL)) |
+                RCC_CFGR_PLLSRC_HSI_DIV2 | RCC_CFGR_PLLMUL12;
+    RCC->CR |= RCC_CR_PLLON;
+    while ((RCC->CR & RCC_CR_PLLRDY) == 0u)
     {
-        // Catch error
-        error_handler();
+        // Wait for the PLL lock
     }
 
-    // Initialize the CPU, AHB and APB buses clocks
-    clk_init_struct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1;
-    clk_init_struct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-    clk_init_struct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-    clk_init_struct.APB1CLKDivider = RCC_HCLK_DIV1;
-    if (HAL_OK != HAL_RCC_ClockConfig(&clk_init_struct, FLASH_LATENCY_1))
+    // System clock on the PLL, AHB and APB undivided
+    RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_SW | RCC_CFGR_HPRE | RCC_CFGR_PPRE)) | RCC_CFGR_SW_PLL;
+    while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL)
     {
-        // Catch error
-        error_handler();
+        // Wait for the switch
     }
 
-    // Select the clocks for the peripherals
-    periph_init_struct.PeriphClockSelection = RCC_PERIPHCLK_USART1 | RCC_PERIPHCLK_I2C1;
-    periph_init_struct.Usart1ClockSelection = RCC_USART1CLKSOURCE_PCLK1;
-    periph_init_struct.I2c1ClockSelection = RCC_I2C1CLKSOURCE_HSI;
-    if (HAL_OK != HAL_RCCEx_PeriphCLKConfig(&periph_init_struct))
-    {
-        // Catch error
-        error_handler();
-    }
+    // Restart the SysTick at the new frequency
+    SystemCoreClock = HW_SYSCLK_MHZ * 1000000u;
+    HAL_InitTick(TICK_INT_PRIORITY);
+
+    // The UART runs on PCLK and the I2C on HSI after the reset, the I2C clock is selected with its speed
 
     // Enable PWR clock for sleep mode functionality
-    __HAL_RCC_PWR_CLK_ENABLE();
+    RCC->APB1ENR |= RCC_APB1ENR_PWREN;
 }
 
 // **********************************************************************************************************
@@ -159,31 +592,53 @@ static void rcc_config(void)
 // **********************************************************************************************************
 static void gpio_config(void)
 {
-    // Variable(s) declaration
-    GPIO_InitTypeDef gpio_init_struct = {0};
-
     // Enable GPIO clocks
-    __HAL_RCC_GPIOA_CLK_ENABLE();
+    RCC->AHBENR |= RCC_AHBENR_GPIOAEN;
 
     // Temperature and humidity sensor
-    gpio_init_struct.Mode = GPIO_MODE_AF_OD;
-    gpio_init_struct.Pull = GPIO_NOPULL;
-    gpio_init_struct.Speed = GPIO_SPEED_FREQ_HIGH;
-    gpio_init_struct.Alternate = GPIO_AF4_I2C1;
-    gpio_init_struct.Pin = TEMP_HUM_SDA_PIN;
-    HAL_GPIO_Init(TEMP_HUM_SDA_PORT, &gpio_init_struct);
-    gpio_init_struct.Pin = TEMP_HUM_SCL_PIN;
-    HAL_GPIO_Init(TEMP_HUM_SCL_PORT, &gpio_init_struct);
-    
+    i2c_gpio_config();
+
     // UART communication
-    gpio_init_struct.Mode = GPIO_MODE_AF_PP;
-    gpio_init_struct.Pull = GPIO_NOPULL;
-    gpio_init_struct.Speed = GPIO_SPEED_FREQ_HIGH;
-    gpio_init_struct.Alternate = GPIO_AF1_USART1;
-    gpio_init_struct.Pin = COM_UART_TX_PIN;
-    HAL_GPIO_Init(COM_UART_TX_PORT, &gpio_init_struct);
-    gpio_init_struct.Pin = COM_UART_RX_PIN; 
-    HAL_GPIO_Init(COM_UART_RX_PORT, &gpio_init_struct);
+    gpio_pin_config(COM_UART_TX_PORT, COM_UART_TX_PIN, HW_GPIO_MODE_ALTERNATE, FALSE, HW_GPIO_AF_USART1);
+    gpio_pin_config(COM_UART_RX_PORT, COM_UART_RX_PIN, HW_GPIO_MODE_ALTERNATE, FALSE, HW_GPIO_AF_USART1);
+}
+
+// **********************************************************************************************************
+// Function name    : gpio_pin_config                                                                       *
+// Description      : Configure a pin, at high speed and without pull resistor.                             *
+// **********************************************************************************************************
+static void gpio_pin_config(GPIO_TypeDef* io_p_port, uint16_t i_pin, uint32_t i_mode, bool_e i_open_drain,
+                            uint32_t i_alternate)
+{
+    // Variable(s) declaration
+    uint32_t position;
+    uint32_t shift;
+
+    // Variable(s) initialization
+    position = 0u;
+    while ((1u << position) != i_pin)
+    {
+        position++;
+    }
+    shift = (position & 7u) * 4u;
+
+    // Alternate function first, so that the pin does not glitch on another function
+    MODIFY_REG(io_p_port->AFR[position >> 3u], 0xFu << shift, i_alternate << shift);
+    MODIFY_REG(io_p_port->OTYPER, i_pin, (i_open_drain == TRUE) ? i_pin : 0u);
+    io_p_port->OSPEEDR |= 3u << (position * 2u);
+    io_p_port->PUPDR &= ~(3u << (position * 2u));
+    MODIFY_REG(io_p_port->MODER, 3u << (position * 2u), i_mode << (position * 2u));
+}
+
+// **********************************************************************************************************
+// Function name    : i2c_gpio_config                                                                       *
+// Description      : Sensor I2C pins configuration function.                                               *
+// **********************************************************************************************************
+static void i2c_gpio_config(void)
+{
+    // SDA and SCL in open-drain alternate function
+    gpio_pin_config(TEMP_HUM_SDA_PORT, TEMP_HUM_SDA_PIN, HW_GPIO_MODE_ALTERNATE, TRUE, HW_GPIO_AF_I2C1);
+    gpio_pin_config(TEMP_HUM_SCL_PORT, TEMP_HUM_SCL_PIN, HW_GPIO_MODE_ALTERNATE, TRUE, HW_GPIO_AF_I2C1);
 }
 
 // **********************************************************************************************************
@@ -194,46 +649,66 @@ static void gpio_config(void)
 // **********************************************************************************************************
 static void tim_config(void)
 {
-    // Variable(s) delcaration
-    TIM_ClockConfigTypeDef clk_config = {0};
-    TIM_MasterConfigTypeDef master_config = {0};
+    // Variable(s) declaration
+    uint32_t period_ticks;
+
+    // Slice the measurement cycle so that the watchdog is refreshed in time at each timer wakeup. A period
+    // longer than HW_WDG_REFRESH_MAX_US costs ge_hw_tim_slices - 1 extra wakeups per cycle (2 for 50 s): the
+    // watchdog cannot be stopped once started and times out after 20.9 s at the fastest LSI, so it cannot
+    // last a cycle longer than that without the core waking up to refresh it
+    ge_hw_tim_slices = (ge_config_period_us + HW_WDG_REFRESH_MAX_US - 1u) / HW_WDG_REFRESH_MAX_US;
+    period_ticks = (CONFIG_GET(CONFIG_KEY_TIM_PERIOD) + 1u + (ge_hw_tim_slices / 2u)) / ge_hw_tim_slices;
 
     // Enable timer clock
-    __HAL_RCC_TIM1_CLK_ENABLE();
-
-    // Initialize the timer handle
-    ge_hw_tim_handle.Instance = TIM;
-    ge_hw_tim_handle.Init.Prescaler = TIM_PRESCALER;
-    ge_hw_tim_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
-    ge_hw_tim_handle.Init.Period = TIM_PERIOD;
-    ge_hw_tim_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
-    ge_hw_tim_handle.Init.RepetitionCounter = 0u;
-    ge_hw_tim_handle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-    if (HAL_OK != HAL_TIM_Base_Init(&ge_hw_tim_handle))
-    {
-        // Catch error
-        error_handler();
-    }
+    RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
 
-    // Configure the clock source
-    clk_config.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
-    if (HAL_OK != HAL_TIM_ConfigClockSource(&ge_hw_tim_handle, &clk_config))
-    {
-        // Catch error
-        error_handler();
-    }
+    // Up-counting on the internal clock (reset values), load the prescaler with an update event and drop its
+    // flag, the timer is started with the task
+    TIM->PSC = CONFIG_GET(CONFIG_KEY_TIM_PRESCALER);
+    TIM->ARR = period_ticks - 1u;
+    TIM->EGR = TIM_EGR_UG;
+    TIM->SR = ~TIM_SR_UIF;
 
-    // Configure the master mode
-    master_config.MasterOutputTrigger = TIM_TRGO_RESET;
-    master_config.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
-    if (HAL_OK != HAL_TIMEx_MasterConfigSynchronization(&ge_hw_tim_handle, &master_config))
-    {
-        // Catch error
-        error_handler();
-    }
+    // Freeze the timer in debug mode
+    DBGMCU->APB2FZ |= DBGMCU_APB2_FZ_DBG_TIM1_STOP;
+}
+
+// **********************************************************************************************************
+// Function name    : ts_tim_config                                                                         *
+// Description      : Timestamp timer configuration function.                                               *
+// **********************************************************************************************************
+static void ts_tim_config(void)
+{
+    // Enable timer clock
+    RCC->APB1ENR |= RCC_APB1ENR_TIM14EN;
+
+    // Load the prescaler with an update event, then let the counter run freely, no interrupt is needed
+    TS_TIM->PSC = TS_TIM_PRESCALER;
+    TS_TIM->ARR = TS_TIM_PERIOD;
+    TS_TIM->EGR = TIM_EGR_UG;
+    TS_TIM->CR1 = TIM_CR1_CEN;
+}
+
+// **********************************************************************************************************
+// Function name    : sleep_tim_config                                                                      *
+// Description      : One-shot sleep timer configuration function.                                          *
+// **********************************************************************************************************
+static void sleep_tim_config(void)
+{
+    // Enable timer clock
+    RCC->APB2ENR |= RCC_APB2ENR_TIM16EN;
+
+    // Load the prescaler with an update event, the period is set at each sleep
+    SLEEP_TIM->PSC = SLEEP_TIM_PRESCALER;
+    SLEEP_TIM->EGR = TIM_EGR_UG;
+
+    // One-shot mode, only the overflow raises the update event
+    SLEEP_TIM->CR1 = TIM_CR1_OPM | TIM_CR1_URS;
+    SLEEP_TIM->SR = ~TIM_SR_UIF;
+    SLEEP_TIM->DIER = TIM_DIER_UIE;
 
     // Freeze the timer in debug mode
-    __HAL_FREEZE_TIM1_DBGMCU();
+    DBGMCU->APB2FZ |= DBGMCU_APB2_FZ_DBG_TIM16_STOP;
 }
 
 // **********************************************************************************************************
@@ -242,38 +717,154 @@ static void tim_config(void)
 // **********************************************************************************************************
 static void i2c_config(void)
 {
-    // Enable I2C clock
-    __HAL_RCC_I2C1_CLK_ENABLE();
-
-    // Initialize I2C handle
-    ge_hw_i2c_handle.Instance = TEMP_HUM_SENSOR;
-    ge_hw_i2c_handle.Init.Timing = TEMP_HUM_SENSOR_TIMING;
-    ge_hw_i2c_handle.Init.OwnAddress1 = 0;
-    ge_hw_i2c_handle.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
-    ge_hw_i2c_handle.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
-    ge_hw_i2c_handle.Init.OwnAddress2 = 0;
-    ge_hw_i2c_handle.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
-    ge_hw_i2c_handle.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
-    ge_hw_i2c_handle.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
-    if (HAL_OK != HAL_I2C_Init(&ge_hw_i2c_handle))
+    // Variable(s) declaration
+    uint32_t clock_hz;
+    uint32_t timing;
+
+    // Enable I2C clock, on the clock fast enough for the bus speed
+    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN;
+    if (CONFIG_GET(CONFIG_KEY_I2C_SPEED) > TEMP_HUM_SENSOR_FAST_MAX_HZ)
+    {
+        RCC->CFGR3 |= RCC_CFGR3_I2C1SW_SYSCLK;
+        clock_hz = TEMP_HUM_SENSOR_CLOCK_SYSCLK_HZ;
+    }
+    else
+    {
+        RCC->CFGR3 &= ~RCC_CFGR3_I2C1SW;
+        clock_hz = TEMP_HUM_SENSOR_CLOCK_HSI_HZ;
+    }
+
+    // The stored timing or the one computed for the speed
+    timing = CONFIG_GET(CONFIG_KEY_I2C_TIMING);
+    if (timing == TEMP_HUM_SENSOR_TIMING_COMPUTED)
     {
-        // Catch error
-        error_handler();
+        timing = i2c_timing(clock_hz, CONFIG_GET(CONFIG_KEY_I2C_SPEED));
     }
 
-    // Configure the analogue filter
-    if (HAL_OK != HAL_I2CEx_ConfigAnalogFilter(&ge_hw_i2c_handle, I2C_ANALOGFILTER_ENABLE))
+    // The timing can only be written with the peripheral disabled. The 7 bits addressing, the analog filter
+    // enabled and the digital filter off are the reset values
+    TEMP_HUM_SENSOR->CR1 = 0u;
+    TEMP_HUM_SENSOR->TIMINGR = timing;
+    TEMP_HUM_SENSOR->CR1 = I2C_CR1_PE;
+}
+
+// **********************************************************************************************************
+// Function name    : i2c_timing                                                                            *
+// Description      : Compute the I2C timing register for a bus speed (reference manual, I2C timings).      *
+// **********************************************************************************************************
+static uint32_t i2c_timing(uint32_t i_clock_hz, uint32_t i_speed_hz)
+{
+    // Variable(s) declaration
+    const hw_i2c_mode_t* p_mode;
+    uint32_t clock_mhz;
+    uint32_t rise;
+    uint32_t fall;
+    uint32_t filter;
+    uint32_t filter_min;
+    uint32_t sync;
+    uint32_t period;
+    uint32_t prescaler;
+    uint32_t low;
+    uint32_t high;
+    uint32_t total;
+    uint32_t data_delay;
+    uint32_t clock_delay;
+
+    // Variable(s) initialization
+    p_mode = &g_hw_i2c_modes[0];
+    while ((i_speed_hz > p_mode->speed_max_hz) && (p_mode < &g_hw_i2c_modes[HW_I2C_MODE_COUNT - 1u]))
     {
-        // Catch error
-        error_handler();
+        p_mode++;
     }
+    clock_mhz = i_clock_hz / 1000000u;
+    prescaler = 0u;
 
-    // Configure the digital filter
-    if (HAL_OK != HAL_I2CEx_ConfigDigitalFilter(&ge_hw_i2c_handle, 0))
+    // Without the computation, the reference timing of the mode
+    if (TEMP_HUM_SENSOR_TIMING_ENABLED == 0u)
     {
-        // Catch error
-        error_handler();
+        return p_mode->timing;
     }
+
+    // Times in kernel clock periods (RM0360, I2C timings): tLOW = tSYNC1 + (SCLL + 1) x tPRESC and tHIGH =
+    // tSYNC2 + (SCLH + 1) x tPRESC, with tSYNC the analog filter delay, ended on a clock edge so rounded up,
+    // and 2 clock periods of synchronization. The slopes only add to the period: the bus never runs faster
+    // than the requested speed when tSYNC1 + tSYNC2 + the counts fill its period
+    rise = HW_I2C_CLOCKS(TEMP_HUM_SENSOR_RISE_NS, clock_mhz);
+    fall = HW_I2C_CLOCKS(TEMP_HUM_SENSOR_FALL_NS, clock_mhz);
+    filter = HW_I2C_CLOCKS(TEMP_HUM_SENSOR_FILTER_NS, clock_mhz);
+    filter_min = (TEMP_HUM_SENSOR_FILTER_NS * clock_mhz) / 1000u;
+    sync = filter + 2u;
+    period = (i_clock_hz + i_speed_hz - 1u) / i_speed_hz;
+    period = (period > (2u * sync)) ? (period - (2u * sync)) : 0u;
+
+    // Smallest prescaler giving counts within the fields, for the finest resolution
+    do
+    {
+        prescaler++;
+
+        // Data hold after the falling edge of SCL: the fall time not covered by the shortest filter delay and
+        // the synchronization. Data setup before the rising edge: the rise time and tSU;DAT
+        data_delay = fall - filter_min - 3u;
+        data_delay = (fall > (filter_min + 3u)) ? ((data_delay + prescaler - 1u) / prescaler) : 0u;
+        clock_delay = rise + HW_I2C_CLOCKS(p_mode->setup_min_ns, clock_mhz);
+        clock_delay = ((clock_delay + prescaler - 1u) / prescaler) - 1u;
+
+        // Low period: tLOW, at least 4 kernel clock periods plus the filter, and room for the data delays.
+        // High period: tHIGH and more than one kernel clock period. Rounded up, both stay above the minimums
+        low = HW_I2C_CLOCKS(p_mode->low_min_ns, clock_mhz);
+        low = (low > (4u + filter)) ? low : (4u + filter);
+        low = (low > sync) ? ((low - sync + prescaler - 1u) / prescaler) : 1u;
+        low = (low > (data_delay + clock_delay + 2u)) ? low : (data_delay + clock_delay + 2u);
+        high = HW_I2C_CLOCKS(p_mode->high_min_ns, clock_mhz);
+        high = (high > sync) ? ((high - sync + prescaler - 1u) / prescaler) : 1u;
+        high = (high > 1u) ? high : 2u;
+
+        // Share the rest of the period in the ratio of the minimum periods, the bus runs slower when the
+        // minimum periods do not fit in it
+        total = (period + prescaler - 1u) / prescaler;
+        if (total > (low + high))
+        {
+            low += ((total - low - high) * p_mode->low_min_ns) / (p_mode->low_min_ns + p_mode->high_min_ns);
+            high = total - low;
+        }
+    } while (((low > HW_I2C_SCL_MAX) || (high > HW_I2C_SCL_MAX) || (data_delay > HW_I2C_DEL_MAX) ||
+              (clock_delay > HW_I2C_DEL_MAX)) && (prescaler <= HW_I2C_PRESC_MAX));
+
+    // Return the register value: PRESC, SCLDEL, SDADEL, SCLH and SCLL, the counts are minus one
+    return ((prescaler - 1u) << I2C_TIMINGR_PRESC_Pos) | (clock_delay << I2C_TIMINGR_SCLDEL_Pos) |
+           (data_delay << I2C_TIMINGR_SDADEL_Pos) | ((high - 1u) << I2C_TIMINGR_SCLH_Pos) |
+           ((low - 1u) << I2C_TIMINGR_SCLL_Pos);
+}
+
+// **********************************************************************************************************
+// Function name    : i2c_wait                                                                              *
+// Description      : Wait for a flag of the sensor I2C during a transfer.                                  *
+// **********************************************************************************************************
+static status_e i2c_wait(uint32_t i_flag, uint32_t i_start_tick, uint32_t i_timeout_ms)
+{
+    // Variable(s) declaration
+    uint32_t isr;
+
+    do
+    {
+        // A NACK ends the transfer with a STOP (automatic end mode), the bus errors abort it
+        isr = TEMP_HUM_SENSOR->ISR;
+        if ((isr & (I2C_ISR_NACKF | I2C_ISR_BERR | I2C_ISR_ARLO)) != 0u)
+        {
+            ge_hw_i2c_error = (((isr & I2C_ISR_NACKF) != 0u) ? HW_I2C_ERROR_NACK : 0u) |
+                              (((isr & I2C_ISR_BERR) != 0u) ? HW_I2C_ERROR_BUS : 0u) |
+                              (((isr & I2C_ISR_ARLO) != 0u) ? HW_I2C_ERROR_ARBITRATION : 0u);
+            return STATUS_ERROR;
+        }
+        if ((HAL_GetTick() - i_start_tick) > i_timeout_ms)
+        {
+            ge_hw_i2c_error = HW_I2C_ERROR_TIMEOUT;
+            return STATUS_TIMEOUT;
+        }
+    } while ((isr & i_flag) == 0u);
+
+    // Return the status of the wait
+    return STATUS_OK;
 }
 
 // **********************************************************************************************************
@@ -283,24 +874,14 @@ static void i2c_config(void)
 static void uart_config(void)
 {
     // Enable UART clock
-    __HAL_RCC_USART1_CLK_ENABLE();
-
-    // Initialize UART handle
-    ge_hw_uart_handle.Instance = COMMUNICATION_UART;
-    ge_hw_uart_handle.Init.BaudRate = COMMUNICATION_UART_BAUDRATE;
-    ge_hw_uart_handle.Init.WordLength = UART_WORDLENGTH_8B;
-    ge_hw_uart_handle.Init.StopBits = UART_STOPBITS_1;
-    ge_hw_uart_handle.Init.Parity = UART_PARITY_NONE;
-    ge_hw_uart_handle.Init.Mode = UART_MODE_TX_RX;
-    ge_hw_uart_handle.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-    ge_hw_uart_handle.Init.OverSampling = UART_OVERSAMPLING_16;
-    ge_hw_uart_handle.Init.OneBitSampling = UART_ONE_BIT_SAMPLE_DISABLE;
-    ge_hw_uart_handle.AdvancedInit.AdvFeatureInit = UART_ADVFEATURE_NO_INIT;
-    if (HAL_OK != HAL_UART_Init(&ge_hw_uart_handle))
-    {
-        // Catch error
-        error_handler();
-    }
+    RCC->APB2ENR |= RCC_APB2ENR_USART1EN;
+
+    // 8 bits, 1 stop bit, no parity, 16 times oversampling (reset values)
+    ge_hw_uart_baudrate = CONFIG_GET(CONFIG_KEY_BAUDRATE);
+    COMMUNICATION_UART->BRR = (COMMUNICATION_UART_CLOCK_HZ + (ge_hw_uart_baudrate / 2u)) / ge_hw_uart_baudrate;
+
+    // Enable the transmitter, the receiver and its interrupt for the station commands
+    COMMUNICATION_UART->CR1 = USART_CR1_TE | USART_CR1_RE | USART_CR1_RXNEIE | USART_CR1_UE;
 }
 
 // **********************************************************************************************************
@@ -312,6 +893,31 @@ static void uart_config(void)
 static void nvic_config(void)
 {
     // Enable IRQ for timer
-    HAL_NVIC_SetPriority(TIM_IT_IRQ, 2, 0);
-    HAL_NVIC_EnableIRQ(TIM_IT_IRQ);
+    NVIC_SetPriority(TIM_IT_IRQ, 2u);
+    NVIC_EnableIRQ(TIM_IT_IRQ);
+
+    // Enable IRQ for the communication UART
+    NVIC_SetPriority(COMMUNICATION_UART_IRQ, 1u);
+    NVIC_EnableIRQ(COMMUNICATION_UART_IRQ);
+
+    // Enable IRQ for the sleep timer
+    NVIC_SetPriority(SLEEP_TIM_IRQ, 2u);
+    NVIC_EnableIRQ(SLEEP_TIM_IRQ);
+}
+
+// **********************************************************************************************************
+// Function name    : delay_us                                                                              *
+// Description      : Busy wait on the timestamp timer.                                                     *
+// **********************************************************************************************************
+static void delay_us(uint16_t i_delay_us)
+{
+    // Variable(s) declaration
+    uint16_t start;
+
+    // Wait on the free-running 1 MHz counter
+    start = HW_TIMESTAMP_GET();
+    while ((uint16_t) (HW_TIMESTAMP_GET() - start) < i_delay_us)
+    {
+        // Busy wait
+    }
 }
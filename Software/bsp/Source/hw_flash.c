@@ -0,0 +1,117 @@
+// **********************************************************************************************************
+// File name        : hw_flash.c                                                                            *
+// Author           : Richard I.                                                                            *
+// Date             : 18/10/2026                                                                            *
+// Description      : Internal flash erase and program helpers.                                             *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include "hw_flash.h"
+
+// **********************************************************************************************************
+//                                       Private fuctions prototype                                         *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : flash_wait                                                                            *
+// Description      : Wait for the end of a flash operation and clear its flags.                            *
+// Argument         : None                                                                                  *
+// Return value     : (status_e) : STATUS_ERROR on a programming or write protection error                  *
+// **********************************************************************************************************
+static status_e flash_wait(void);
+
+// **********************************************************************************************************
+//                                            Public fuctions                                               *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : hw_flash_erase_page                                                                   *
+// Description      : Erase a flash page.                                                                   *
+// **********************************************************************************************************
+status_e hw_flash_erase_page(uint32_t i_address)
+{
+    // Variable(s) declaration
+    status_e r_status;
+
+    // Unlock the flash controller
+    FLASH->KEYR = FLASH_KEY1;
+    FLASH->KEYR = FLASH_KEY2;
+
+    // Erase the page, the core stalls on the flash meanwhile
+    FLASH->CR |= FLASH_CR_PER;
+    FLASH->AR = i_address;
+    FLASH->CR |= FLASH_CR_STRT;
+    r_status = flash_wait();
+    FLASH->CR &= ~FLASH_CR_PER;
+
+    // Lock it back
+    FLASH->CR |= FLASH_CR_LOCK;
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+// Function name    : hw_flash_program                                                                      *
+// Description      : Program a buffer in erased flash, half-word by half-word.                             *
+// **********************************************************************************************************
+status_e hw_flash_program(uint32_t i_address, const void* i_p_data, size_t i_size)
+{
+    // Variable(s) declaration
+    const uint16_t* p_data;
+    volatile uint16_t* p_flash;
+    status_e r_status;
+    size_t index;
+
+    // Variable(s) initialization
+    p_data = (const uint16_t*) i_p_data;
+    p_flash = (volatile uint16_t*) i_address;
+    r_status = STATUS_OK;
+
+    // Unlock the flash controller
+    FLASH->KEYR = FLASH_KEY1;
+    FLASH->KEYR = FLASH_KEY2;
+
+    // Program each half-word and check it
+    FLASH->CR |= FLASH_CR_PG;
+    for (index = 0u ; (index < (i_size / 2u)) && (r_status == STATUS_OK) ; index++)
+    {
+        p_flash[index] = p_data[index];
+        if ((flash_wait() != STATUS_OK) || (p_flash[index] != p_data[index]))
+        {
+            // Error: update the status
+            r_status = STATUS_ERROR;
+        }
+    }
+    FLASH->CR &= ~FLASH_CR_PG;
+
+    // Lock it back
+    FLASH->CR |= FLASH_CR_LOCK;
+
+    // Return the status of the operation
+    return r_status;
+}
+
+// **********************************************************************************************************
+//                                            Private fuctions                                              *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : flash_wait                                                                            *
+// Description      : Wait for the end of a flash operation and clear its flags.                            *
+// **********************************************************************************************************
+static status_e flash_wait(void)
+{
+    // Variable(s) declaration
+    status_e r_status;
+
+    while ((FLASH->SR & FLASH_SR_BSY) != 0u)
+    {
+        // Wait for the end of the operation
+    }
+
+    // Check the errors, then clear the flags (written 1 to clear)
+    r_status = ((FLASH->SR & (FLASH_SR_PGERR | FLASH_SR_WRPERR)) != 0u) ? STATUS_ERROR : STATUS_OK;
+    FLASH->SR = FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPERR;
+
+    // Return the status of the operation
+    return r_status;
+}
@@ -23,6 +23,10 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "com.h"
+#include "prof.h"
+#include "trace.h"
+#include "fault.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -67,45 +71,37 @@
 /**
   * @brief This function handles Non maskable interrupt.
   */
-void NMI_Handler(void)
+__attribute__((naked)) void NMI_Handler(void)
 {
-  while (1)
-  {
-    __asm("bkpt");
-  }
+  // Save the faulting context and reset
+  FAULT_EXCEPTION_ENTRY();
 }
 
 /**
   * @brief This function handles Hard fault interrupt.
   */
-void HardFault_Handler(void)
+__attribute__((naked)) void HardFault_Handler(void)
 {
-  while (1)
-  {
-    __asm("bkpt");
-  }
+  // Save the faulting context and reset
+  FAULT_EXCEPTION_ENTRY();
 }
 
 /**
   * @brief This function handles System service call via SWI instruction.
   */
-void SVC_Handler(void)
+__attribute__((naked)) void SVC_Handler(void)
 {
-  while (1)
-  {
-    __asm("bkpt");
-  }
+  // Save the faulting context and reset
+  FAULT_EXCEPTION_ENTRY();
 }
 
 /**
   * @brief This function handles Pendable request for system service.
   */
-void PendSV_Handler(void)
+__attribute__((naked)) void PendSV_Handler(void)
 {
-  while (1)
-  {
-    __asm("bkpt");
-  }
+  // Save the faulting context and reset
+  FAULT_EXCEPTION_ENTRY();
 }
 
 /**
@@ -114,6 +110,7 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   HAL_IncTick();
+  TRACE_EVENT(TRACE_EVENT_SYSTICK, HAL_GetTick());
 }
 
 /**
@@ -121,19 +118,59 @@ void SysTick_Handler(void)
   */
 void TIM_IT_IRQ_HANDLER(void)
 {
+  // The wakeup phase lasts until the task starts
+  PROF_START(PROF_PHASE_WAKEUP);
+  TRACE_EVENT(TRACE_EVENT_TIM_IRQ, 0u);
+
   // Enable back SysTick
+  PROF_START(PROF_PHASE_CLOCK_RESTORE);
   HAL_ResumeTick();
+  PROF_STOP(PROF_PHASE_CLOCK_RESTORE);
 
-  // Call HAL dedicated handler
-  HAL_TIM_IRQHandler(&ge_hw_tim_handle);
+  // The period has elapsed
+  if ((TIM->SR & TIM_SR_UIF) != 0u)
+  {
+    TIM->SR = ~TIM_SR_UIF;
+
+    // Count the period for the device clock
+    ge_hw_tim_periods++;
+
+    // Every period refreshes the watchdog in the main loop, only the last slice of the cycle requests the task
+    ge_wdg_request = TRUE;
+    if (++ge_hw_tim_slice >= (int32_t) ge_hw_tim_slices)
+    {
+      // Wake up the main process and request the task
+      ge_hw_tim_slice = 0;
+      ge_task_request = TRUE;
+    }
+  }
 }
 
 /**
-  * @brief This function handles the perdiod elapsed callback.
+  * @brief This function handles the sleep timer interrupt.
   */
-void TIM_UP_CALLBACK(TIM_HandleTypeDef* i_p_handle)
+void SLEEP_TIM_IRQ_HANDLER(void)
 {
-  // Wake up the main process and do nothing more
+  // Only wake the core up, the sleep loop watches the end of the one-shot count
+  SLEEP_TIM->SR = ~TIM_SR_UIF;
+}
+
+/**
+  * @brief This function handles the communication UART interrupts.
+  */
+void COMMUNICATION_UART_IRQ_HANDLER(void)
+{
+  // Clear an overrun so that the reception goes on
+  if ((COMMUNICATION_UART->ISR & USART_ISR_ORE) != 0u)
+  {
+    COMMUNICATION_UART->ICR = USART_ICR_ORECF;
+  }
+
+  // Hand the received byte over to the command parser
+  if ((COMMUNICATION_UART->ISR & USART_ISR_RXNE) != 0u)
+  {
+    com_receive_byte((uint8_t) COMMUNICATION_UART->RDR);
+  }
 }
 
 /******************************************************************************/
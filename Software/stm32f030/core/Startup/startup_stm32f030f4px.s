@@ -85,6 +85,23 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Paint the stack reservation only, below the stack pointer, to measure its usage: the rest of the free RAM
+   would delay the first measurement for nothing */
+  ldr r2, =_estack
+  ldr r3, =_Min_Stack_Size
+  subs r2, r2, r3
+  mov r4, sp
+  ldr r3, =0xCDCDCDCD
+  b LoopPaintStack
+
+PaintStack:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
 /* Call static constructors */
   bl __libc_init_array
 /* Call the application's entry point.*/
@@ -98,16 +115,16 @@ LoopForever:
 
 /**
  * @brief  This is the code that gets called when the processor receives an
- *         unexpected interrupt.  This simply enters an infinite loop, preserving
- *         the system state for examination by a debugger.
+ *         unexpected interrupt.  It is handled as a fault: the context is saved
+ *         with the exception number and the MCU resets.
  *
  * @param  None
  * @retval : None
 */
     .section .text.Default_Handler,"ax",%progbits
 Default_Handler:
-Infinite_Loop:
-  b Infinite_Loop
+  ldr r0, =HardFault_Handler
+  bx r0
   .size Default_Handler, .-Default_Handler
 /******************************************************************************
 *
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+# **********************************************************************************************************
+# File name         : com_frames.py                                                                        *
+# Author            : Richard I.                                                                           *
+# Date              : 18/10/2026                                                                           *
+# Description       : Parser of the frames sent by the sensor (see app/Include/com.h)                      *
+# **********************************************************************************************************
+import sys
+
+# Frame layout: start of frame, type, payload size, payload, CRC8 over type, size and payload
+FRAME_SOF = 0xA5
+
+# Frame types
+FRAME_MEASUREMENT = 0x01
+FRAME_PROFILE = 0x10
+FRAME_TRACE = 0x11
+
+
+def crc8(data, crc=0xFF):
+    """CRC8 with polynomial 0x31, same as the firmware."""
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x31) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def iter_frames(data):
+    """Yield (type, payload) for every valid frame found in a byte stream."""
+    index = 0
+    while index + 4 <= len(data):
+        if data[index] != FRAME_SOF:
+            index += 1
+            continue
+        frame_type, size = data[index + 1], data[index + 2]
+        end = index + 3 + size
+        if end >= len(data):
+            break
+        if crc8(data[index + 1:end]) == data[end]:
+            yield frame_type, bytes(data[index + 3:end])
+            index = end + 1
+        else:
+            index += 1
+
+
+def read_input(path):
+    """Read a raw capture of the UART from a file, or from stdin when path is '-'."""
+    if path == '-':
+        return sys.stdin.buffer.read()
+    with open(path, 'rb') as capture:
+        return capture.read()
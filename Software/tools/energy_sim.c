@@ -0,0 +1,250 @@
+// **********************************************************************************************************
+// File name         : energy_sim.c                                                                         *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Host-side energy model: replays the cycle of task() with the firmware sensor driver, *
+//                   : frame sizes, bus times and estimator (app/Source/energy.c) for offline what-if       *
+//                   : analysis. Only the awake time of the cycle is a model, the firmware measures it.     *
+//                   : Usage: energy_sim [period_s] [precision 0-2] [baudrate] [cycles] [i2c_speed_hz]      *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include "energy.h"
+#include "config.h"
+#include "task.h"
+#include "diag.h"
+#include "sht4x_driver.h"
+#include "clock.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Software overhead of a cycle on top of the bus transfers
+#define SIM_OVERHEAD_US                         (150u)
+
+// **********************************************************************************************************
+//                                              Variables                                                   *
+// **********************************************************************************************************
+// Parameters read by the estimator and the bus time of the transfers
+uint32_t ge_config[CONFIG_KEY_COUNT];
+
+// Baudrate of the simulated line, and bus times of the current cycle
+static uint32_t g_sim_baudrate;
+static uint32_t g_sim_i2c_us;
+static uint32_t g_sim_uart_us;
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : sim_i2c_send                                                                          *
+// Description      : Send function of the sensor driver, accounts the transfer like i2c_send_function.     *
+// Argument         : (uint8_t) i_address: Sensor address                                                   *
+//                  : (uint8_t*) i_p_data: Data to send                                                     *
+//                  : (size_t) i_size: Size of the data                                                     *
+// Return value     : (status_e) : STATUS_OK                                                                *
+// **********************************************************************************************************
+static status_e sim_i2c_send(uint8_t i_address, uint8_t* i_p_data, size_t i_size);
+
+// **********************************************************************************************************
+// Function name    : sim_i2c_receive                                                                       *
+// Description      : Receive function of the sensor driver, accounts the transfer like                     *
+//                    i2c_receive_function and returns words of 0 with their CRC.                           *
+// Argument         : (uint8_t) i_address: Sensor address                                                   *
+//                  : (uint8_t*) o_p_data: Received data                                                    *
+//                  : (size_t) i_size: Size of the data                                                     *
+// Return value     : (status_e) : STATUS_OK                                                                *
+// **********************************************************************************************************
+static status_e sim_i2c_receive(uint8_t i_address, uint8_t* o_p_data, size_t i_size);
+
+// **********************************************************************************************************
+// Function name    : sim_delay                                                                             *
+// Description      : Delay function of the sensor driver, the conversions are accounted by the cycle.      *
+// Argument         : (uint32_t) i_delay_ms: Delay in milliseconds                                          *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sim_delay(uint32_t i_delay_ms);
+
+// **********************************************************************************************************
+// Function name    : sim_send_frame                                                                        *
+// Description      : Account a frame like com_send_frame.                                                  *
+// Argument         : (uint32_t) i_size: Payload size                                                       *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sim_send_frame(uint32_t i_size);
+
+// **********************************************************************************************************
+//                                            Public fuctions                                               *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : main                                                                                  *
+// Description      : Run the simulation and print the energy report at each heartbeat.                     *
+// **********************************************************************************************************
+int main(int argc, char** argv)
+{
+    // Variable(s) declaration
+    sht4x_handle_t* p_sensor;
+    uint32_t period_us;
+    uint32_t precision;
+    uint32_t cycles;
+    uint32_t cycle;
+    uint32_t conversion_us;
+    uint32_t active_us;
+    int16_t temperature;
+    uint16_t humidity;
+    energy_report_t report;
+
+    // Parse the arguments
+    period_us = ((argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : 50u) * 1000000u;
+    precision = (argc > 2) ? (uint32_t) strtoul(argv[2], NULL, 0) : SHT4x_PRECISION_HIGH;
+    g_sim_baudrate = (argc > 3) ? (uint32_t) strtoul(argv[3], NULL, 0) : 9600u;
+    cycles = (argc > 4) ? (uint32_t) strtoul(argv[4], NULL, 0) : 120u;
+    ge_config[CONFIG_KEY_I2C_SPEED] = (argc > 5) ? (uint32_t) strtoul(argv[5], NULL, 0) : 100000u;
+    if (precision > SHT4x_PRECISION_HIGH)
+    {
+        precision = SHT4x_PRECISION_HIGH;
+    }
+
+    // Default currents of the firmware parameters
+    ge_config[CONFIG_KEY_ENERGY_CURRENT_SLEEP] = ENERGY_CURRENT_SLEEP_UA;
+    ge_config[CONFIG_KEY_ENERGY_CURRENT_ACTIVE] = ENERGY_CURRENT_ACTIVE_UA;
+    ge_config[CONFIG_KEY_ENERGY_CURRENT_I2C] = ENERGY_CURRENT_I2C_UA;
+    ge_config[CONFIG_KEY_ENERGY_CURRENT_UART] = ENERGY_CURRENT_UART_UA;
+    ge_config[CONFIG_KEY_ENERGY_CURRENT_CONVERSION] = ENERGY_CURRENT_CONVERSION_UA;
+    ge_config[CONFIG_KEY_ENERGY_CURRENT_HEATER] = ENERGY_CURRENT_HEATER_UA;
+
+    // The firmware driver does the transfers
+    p_sensor = sht4x_init(SHT4x_A, sim_i2c_send, sim_i2c_receive, sim_delay);
+
+    // Simulate the cycles
+    for (cycle = 1u ; cycle <= cycles ; cycle++)
+    {
+        g_sim_i2c_us = 0u;
+        g_sim_uart_us = 0u;
+
+        // Start the conversion, the previous measurement is sent meanwhile, then read the result
+        (void) sht4x_start_measurement(p_sensor, (sht4x_precision_e) precision);
+        conversion_us = sht4x_get_measurement_time((sht4x_precision_e) precision) * 1000u;
+        energy_add(ENERGY_STATE_CONVERSION, conversion_us);
+        sim_send_frame(TASK_MESSAGE_SIZE);
+        active_us = (conversion_us > g_sim_uart_us) ? conversion_us : g_sim_uart_us;
+        g_sim_uart_us = 0u;
+        (void) sht4x_read_measurement(p_sensor, &temperature, &humidity);
+
+        // Heartbeat, and diagnostic counters every few heartbeats
+        if ((cycle % TASK_HEARTBEAT_PERIOD) == 0u)
+        {
+            sim_send_frame(TASK_HEARTBEAT_SIZE);
+            if ((cycle % (TASK_HEARTBEAT_PERIOD * TASK_DIAG_PERIOD)) == 0u)
+            {
+                sim_send_frame(DIAG_REPORT_SIZE);
+            }
+
+            energy_get_report(&report);
+            printf("cycle %6u: %8u uAh consumed, %6u uA average, %8u h battery life\n",
+                   (unsigned) cycle, (unsigned) report.consumed_uah, (unsigned) report.average_ua,
+                   (unsigned) report.battery_life_h);
+        }
+
+        // Close the cycle
+        active_us += g_sim_i2c_us + g_sim_uart_us + SIM_OVERHEAD_US;
+        energy_add(ENERGY_STATE_ACTIVE, active_us);
+        energy_cycle_end(period_us);
+    }
+
+    // Final report
+    energy_get_report(&report);
+    printf("final       : %8u uAh consumed, %6u uA average, %8u h battery life\n",
+           (unsigned) report.consumed_uah, (unsigned) report.average_ua, (unsigned) report.battery_life_h);
+
+    return 0;
+}
+
+// **********************************************************************************************************
+// Function name    : clock_divide                                                                          *
+// Description      : Host division of the estimator, the firmware divides bit by bit (app/Source/clock.c). *
+// **********************************************************************************************************
+uint64_t clock_divide(uint64_t i_dividend, uint32_t i_divisor)
+{
+    return i_dividend / i_divisor;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : sim_i2c_send                                                                          *
+// Description      : Send function of the sensor driver.                                                   *
+// **********************************************************************************************************
+static status_e sim_i2c_send(uint8_t i_address, uint8_t* i_p_data, size_t i_size)
+{
+    // Variable(s) declaration
+    uint32_t bus_us;
+
+    // Variable(s) initialization
+    (void) i_address;
+    (void) i_p_data;
+    bus_us = ENERGY_I2C_US(i_size, CONFIG_GET(CONFIG_KEY_I2C_SPEED));
+
+    // Account the transfer
+    energy_add(ENERGY_STATE_I2C, bus_us);
+    g_sim_i2c_us += bus_us;
+
+    return STATUS_OK;
+}
+
+// **********************************************************************************************************
+// Function name    : sim_i2c_receive                                                                       *
+// Description      : Receive function of the sensor driver.                                                *
+// **********************************************************************************************************
+static status_e sim_i2c_receive(uint8_t i_address, uint8_t* o_p_data, size_t i_size)
+{
+    // Variable(s) declaration
+    uint32_t bus_us;
+    size_t index;
+
+    // Variable(s) initialization
+    (void) i_address;
+    bus_us = ENERGY_I2C_US(i_size, CONFIG_GET(CONFIG_KEY_I2C_SPEED));
+
+    // Words of 0, each followed by its CRC
+    for (index = 0u ; index < i_size ; index++)
+    {
+        o_p_data[index] = ((index % 3u) == 2u) ? 0x81u : 0x00u;
+    }
+
+    // Account the transfer
+    energy_add(ENERGY_STATE_I2C, bus_us);
+    g_sim_i2c_us += bus_us;
+
+    return STATUS_OK;
+}
+
+// **********************************************************************************************************
+// Function name    : sim_delay                                                                             *
+// Description      : Delay function of the sensor driver.                                                  *
+// **********************************************************************************************************
+static void sim_delay(uint32_t i_delay_ms)
+{
+    (void) i_delay_ms;
+}
+
+// **********************************************************************************************************
+// Function name    : sim_send_frame                                                                        *
+// Description      : Account a frame like com_send_frame.                                                  *
+// **********************************************************************************************************
+static void sim_send_frame(uint32_t i_size)
+{
+    // Variable(s) declaration
+    uint32_t line_us;
+
+    // Variable(s) initialization
+    line_us = ENERGY_FRAME_US(i_size, g_sim_baudrate);
+
+    // Account the transmission
+    energy_add(ENERGY_STATE_UART, line_us);
+    g_sim_uart_us += line_us;
+}
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+# **********************************************************************************************************
+# File name         : map_budget.py                                                                        *
+# Author            : Richard I.                                                                           *
+# Date              : 18/10/2026                                                                           *
+# Description       : Per-symbol RAM and flash budget from the linker map file                             *
+#                   : Usage: map_budget.py [_Build/temperature_sensor.map] [--top N]                       *
+# **********************************************************************************************************
+import argparse
+import re
+import sys
+
+# Output sections loaded from flash but living in RAM
+RAM_LOADED_SECTIONS = ('.data',)
+
+# Input section line, the name may be alone on its line when it is too long
+INPUT_RE = re.compile(r'^ (\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s*(.*))?$')
+WRAPPED_RE = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s*(.*)$')
+OUTPUT_RE = re.compile(r'^(\.\S+|\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)')
+REGION_RE = re.compile(r'^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)')
+
+
+def parse(lines):
+    """Return the memory regions and the list of (output section, input section, object, address, size)."""
+    regions = {}
+    entries = []
+    in_memory = False
+    in_map = False
+    output = None
+    pending = None
+    for line in lines:
+        line = line.rstrip('\n')
+        if line.startswith('Memory Configuration'):
+            in_memory = True
+            continue
+        if line.startswith('Linker script and memory map'):
+            in_memory = False
+            in_map = True
+            continue
+        if in_memory:
+            match = REGION_RE.match(line)
+            if match and match.group(1) not in ('Name', '*default*'):
+                regions[match.group(1)] = (int(match.group(2), 16), int(match.group(3), 16))
+            continue
+        if not in_map:
+            continue
+
+        # Name of an input section wrapped on the next line
+        if pending is not None:
+            match = WRAPPED_RE.match(line)
+            if match:
+                entries.append((output, pending, match.group(3), int(match.group(1), 16), int(match.group(2), 16)))
+            pending = None
+            continue
+
+        # Output section
+        match = OUTPUT_RE.match(line)
+        if match and not line.startswith(' '):
+            output = match.group(1)
+            continue
+        if line and not line.startswith(' ') and line.startswith('.'):
+            output = line.split()[0]
+            continue
+
+        # Input section
+        match = INPUT_RE.match(line)
+        if match and output is not None:
+            name = match.group(1)
+            if not (name.startswith('.') or name in ('COMMON', '*fill*')):
+                continue
+            if match.group(2) is None:
+                pending = name
+            else:
+                entries.append((output, name, match.group(4), int(match.group(2), 16), int(match.group(3), 16)))
+    return regions, entries
+
+
+def region_of(regions, address):
+    """Name of the memory region containing an address."""
+    for name, (origin, length) in regions.items():
+        if origin <= address < origin + length:
+            return name
+    return None
+
+
+def symbol_name(section):
+    """Symbol name from an input section (-ffunction-sections / -fdata-sections)."""
+    for prefix in ('.text.', '.rodata.', '.data.', '.bss.'):
+        if section.startswith(prefix):
+            return section[len(prefix):]
+    return section
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Per-symbol RAM and flash budget from the linker map file')
+    parser.add_argument('map', nargs='?', default='_Build/temperature_sensor.map')
+    parser.add_argument('--top', type=int, default=25, help='number of symbols listed per region')
+    args = parser.parse_args()
+
+    with open(args.map) as map_file:
+        regions, entries = parse(map_file)
+
+    # Charge each input section to its region(s)
+    budget = {name: [] for name in regions}
+    for output, section, obj, address, size in entries:
+        if size == 0:
+            continue
+        region = region_of(regions, address)
+        if region is None:
+            continue
+        item = (size, symbol_name(section), output, obj.split('/')[-1])
+        budget[region].append(item)
+        if output in RAM_LOADED_SECTIONS and 'FLASH' in budget:
+            budget['FLASH'].append(item)
+
+    for name, (origin, length) in regions.items():
+        items = sorted(budget[name], reverse=True)
+        used = sum(item[0] for item in items)
+        print('%s: %d / %d bytes used (%.1f %%), %d free' % (name, used, length, 100.0 * used / length, length - used))
+        for size, symbol, output, obj in items[:args.top]:
+            print('  %6d  %-40s %-18s %s' % (size, symbol, output, obj))
+        print()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
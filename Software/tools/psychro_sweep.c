@@ -0,0 +1,215 @@
+// **********************************************************************************************************
+// File name         : psychro_sweep.c                                                                      *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Host-side check of the integer psychrometric kernels (app/Source/psychro.c):         *
+//                   : compares every code of the useful range, and the other codes with a stride,          *
+//                   : against a floating point reference and fails when an error goes over its limit.      *
+//                   : The cost of each kernel on the target is in the profile report                       *
+//                   : (PROF_PHASE_DEW_POINT and the next phases).                                          *
+//                   : Usage: psychro_sweep [stride], a stride of 1 sweeps all the codes (minutes)          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "psychro.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Magnus coefficients (same as psychro.c)
+#define SWEEP_MAGNUS_B                          (17.62)
+#define SWEEP_MAGNUS_C                          (243.12)
+
+// Default stride of the codes out of the useful range, the clamped inputs only repeat the errors of its edges
+#define SWEEP_STRIDE                            (251u)
+
+// Largest error accepted for each kernel (output units), the full sweep gives 0.57, 5.95 and 12.98
+#define SWEEP_MAX_ERROR_DEW_POINT               (1.0)
+#define SWEEP_MAX_ERROR_ABSOLUTE_HUMIDITY       (8.0)
+#define SWEEP_MAX_ERROR_HEAT_INDEX              (15.0)
+
+// Worst error of one kernel
+typedef struct
+{
+    double error;
+    int16_t temperature;
+    uint16_t humidity;
+} sweep_error_t;
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : sweep_reference                                                                       *
+// Description      : Floating point reference of the three kernels, with the same clamping.                *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+//                  : (double*) o_p_values: Dew point, absolute humidity and heat index (output units)      *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sweep_reference(int16_t i_temperature, uint16_t i_humidity, double* o_p_values);
+
+// **********************************************************************************************************
+// Function name    : sweep_check                                                                           *
+// Description      : Compare the kernels with the reference at one point and keep the worst errors.        *
+// Argument         : (int16_t) i_temperature: Temperature (0.1 degree Celsius)                             *
+//                  : (uint16_t) i_humidity: Relative humidity (0.1 %RH)                                    *
+//                  : (sweep_error_t*) io_p_worst: Worst error of each kernel                               *
+// Return value     : None                                                                                  *
+// **********************************************************************************************************
+static void sweep_check(int16_t i_temperature, uint16_t i_humidity, sweep_error_t* io_p_worst);
+
+// **********************************************************************************************************
+//                                            Public fuctions                                               *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : main                                                                                  *
+// Description      : Run the sweep and print the results.                                                  *
+// **********************************************************************************************************
+int main(int argc, char** argv)
+{
+    // Variable(s) declaration
+    uint32_t stride;
+    int32_t temperature;
+    uint32_t humidity;
+    uint32_t index;
+    int r_exit;
+    sweep_error_t worst[3] = {{0.0, 0, 0u}, {0.0, 0, 0u}, {0.0, 0, 0u}};
+    static const char* names[3] = {"dew point (0.1 C)", "absolute humidity (0.01 g/m3)", "heat index (0.1 C)"};
+    static const double limits[3] = {SWEEP_MAX_ERROR_DEW_POINT, SWEEP_MAX_ERROR_ABSOLUTE_HUMIDITY,
+                                     SWEEP_MAX_ERROR_HEAT_INDEX};
+
+    // Variable(s) initialization
+    r_exit = EXIT_SUCCESS;
+
+    // Parse the arguments, a stride of 1 compares all the codes
+    stride = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : SWEEP_STRIDE;
+    if (stride == 0u)
+    {
+        stride = 1u;
+    }
+
+    // Every code of the useful range, with the humidity codes just out of it
+    for (temperature = PSYCHRO_TEMPERATURE_MIN ; temperature <= PSYCHRO_TEMPERATURE_MAX ; temperature++)
+    {
+        for (humidity = 0u ; humidity <= (PSYCHRO_HUMIDITY_MAX + 1u) ; humidity++)
+        {
+            sweep_check((int16_t) temperature, (uint16_t) humidity, worst);
+        }
+    }
+
+    // All the codes with the stride, the last code of each axis included
+    for (temperature = INT16_MIN ; temperature <= INT16_MAX ;
+         temperature = (temperature == (INT16_MAX - 1)) ? INT16_MAX : (temperature + (int32_t) stride))
+    {
+        for (humidity = 0u ; humidity <= UINT16_MAX ;
+             humidity = (humidity == (UINT16_MAX - 1u)) ? UINT16_MAX : (humidity + stride))
+        {
+            sweep_check((int16_t) temperature, (uint16_t) humidity, worst);
+        }
+    }
+
+    // Print the worst errors against their thresholds
+    for (index = 0u ; index < 3u ; index++)
+    {
+        printf("%-30s: max error %6.2f at %6d, %5u (limit %6.2f)%s\n", names[index], worst[index].error,
+               worst[index].temperature, (unsigned) worst[index].humidity, limits[index],
+               (worst[index].error > limits[index]) ? " FAILED" : "");
+        if (worst[index].error > limits[index])
+        {
+            r_exit = EXIT_FAILURE;
+        }
+    }
+
+    return r_exit;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : sweep_check                                                                           *
+// Description      : Compare the kernels with the reference at one point.                                  *
+// **********************************************************************************************************
+static void sweep_check(int16_t i_temperature, uint16_t i_humidity, sweep_error_t* io_p_worst)
+{
+    // Variable(s) declaration
+    double reference[3];
+    double value[3];
+    double error;
+    uint32_t index;
+
+    // Variable(s) initialization
+    sweep_reference(i_temperature, i_humidity, reference);
+    value[0] = psychro_dew_point(i_temperature, i_humidity);
+    value[1] = psychro_absolute_humidity(i_temperature, i_humidity);
+    value[2] = psychro_heat_index(i_temperature, i_humidity);
+
+    // Keep the worst error of each kernel
+    for (index = 0u ; index < 3u ; index++)
+    {
+        error = fabs(value[index] - reference[index]);
+        if (error > io_p_worst[index].error)
+        {
+            io_p_worst[index].error = error;
+            io_p_worst[index].temperature = i_temperature;
+            io_p_worst[index].humidity = i_humidity;
+        }
+    }
+}
+
+// **********************************************************************************************************
+// Function name    : sweep_reference                                                                       *
+// Description      : Floating point reference of the three kernels, with the same clamping.                *
+// **********************************************************************************************************
+static void sweep_reference(int16_t i_temperature, uint16_t i_humidity, double* o_p_values)
+{
+    // Variable(s) declaration
+    double t;
+    double rh;
+    double gamma;
+    double f;
+    double hi;
+
+    // Clamp the inputs
+    t = i_temperature;
+    t = (t < PSYCHRO_TEMPERATURE_MIN) ? PSYCHRO_TEMPERATURE_MIN : ((t > PSYCHRO_TEMPERATURE_MAX) ?
+        PSYCHRO_TEMPERATURE_MAX : t);
+    rh = i_humidity;
+    rh = (rh < PSYCHRO_HUMIDITY_MIN) ? PSYCHRO_HUMIDITY_MIN : ((rh > PSYCHRO_HUMIDITY_MAX) ?
+         PSYCHRO_HUMIDITY_MAX : rh);
+    t /= 10.0;
+    rh /= 10.0;
+
+    // Dew point
+    gamma = log(rh / 100.0) + ((SWEEP_MAGNUS_B * t) / (SWEEP_MAGNUS_C + t));
+    o_p_values[0] = ((SWEEP_MAGNUS_C * gamma) / (SWEEP_MAGNUS_B - gamma)) * 10.0;
+
+    // Absolute humidity
+    o_p_values[1] = ((6.112 * exp((SWEEP_MAGNUS_B * t) / (SWEEP_MAGNUS_C + t)) * rh * 2.1674) /
+                     (273.15 + t)) * 100.0;
+    o_p_values[1] = (o_p_values[1] > 65535.0) ? 65535.0 : o_p_values[1];
+
+    // Heat index (NWS)
+    f = (t * 1.8) + 32.0;
+    hi = 0.5 * (f + 61.0 + ((f - 68.0) * 1.2) + (rh * 0.094));
+    if (((hi + f) / 2.0) >= 80.0)
+    {
+        hi = -42.379 + (2.04901523 * f) + (10.14333127 * rh) - (0.22475541 * f * rh) - (0.00683783 * f * f) -
+             (0.05481717 * rh * rh) + (0.00122874 * f * f * rh) + (0.00085282 * f * rh * rh) -
+             (0.00000199 * f * f * rh * rh);
+        if ((rh < 13.0) && (f >= 80.0) && (f <= 112.0))
+        {
+            hi -= ((13.0 - rh) / 4.0) * sqrt((17.0 - fabs(f - 95.0)) / 17.0);
+        }
+        if ((rh > 85.0) && (f >= 80.0) && (f <= 87.0))
+        {
+            hi += ((rh - 85.0) / 10.0) * ((87.0 - f) / 5.0);
+        }
+    }
+    o_p_values[2] = ((hi - 32.0) / 1.8) * 10.0;
+}
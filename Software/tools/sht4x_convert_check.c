@@ -0,0 +1,268 @@
+// **********************************************************************************************************
+// File name         : sht4x_convert_check.c                                                                *
+// Author            : Richard I.                                                                           *
+// Date              : 18/10/2026                                                                           *
+// Description       : Host-side exhaustive check of the raw word conversions of the driver                 *
+//                   : (app/Source/sht4x_driver.c): every raw code is compared against the datasheet       *
+//                   : formulas evaluated with exact integer arithmetic, then the calibrated conversions   *
+//                   : are compared against a floating point reference for a grid of gains and offsets.    *
+//                   : Usage: sht4x_convert_check (exit code 1 on the first mismatch)                       *
+// **********************************************************************************************************
+// **********************************************************************************************************
+//                                               Include                                                    *
+// **********************************************************************************************************
+#include <stdio.h>
+#include <math.h>
+#include "sht4x_driver.h"
+
+// **********************************************************************************************************
+//                                               Defines                                                    *
+// **********************************************************************************************************
+// Calibrations checked: Q15 gains from 0.5 to 1.5 and offsets in 0.01 unit
+static const uint16_t g_check_gains[] = {16384u, 29491u, 32768u, 32889u, 36045u, 49152u};
+static const int16_t g_check_offsets[] = {-1000, -137, 0, 250, 1000};
+
+// **********************************************************************************************************
+//                                      Private fuctions prototype                                          *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : check_round                                                                           *
+// Description      : Reference of offset + multiplier . code / 65535 rounded to the nearest.               *
+// Argument         : (int64_t) i_multiplier: Multiplier                                                    *
+//                  : (int64_t) i_offset: Offset                                                            *
+//                  : (uint32_t) i_code: Raw code                                                           *
+// Return value     : (int64_t) : Result                                                                    *
+// **********************************************************************************************************
+static int64_t check_round(int64_t i_multiplier, int64_t i_offset, uint32_t i_code);
+
+// **********************************************************************************************************
+// Function name    : check_crop                                                                            *
+// Description      : Crop a value to [0, max].                                                             *
+// Argument         : (int64_t) i_value: Value                                                              *
+//                  : (int64_t) i_max: Maximum                                                              *
+// Return value     : (int64_t) : Cropped value                                                             *
+// **********************************************************************************************************
+static int64_t check_crop(int64_t i_value, int64_t i_max);
+
+// **********************************************************************************************************
+// Function name    : check_exact                                                                           *
+// Description      : Check the conversions without calibration against the exact datasheet formulas.       *
+// Argument         : (const sht4x_handle_t*) i_p_handle: Handle of the converted sensor                    *
+// Return value     : (int) : 0 if every code matches, 1 otherwise                                          *
+// **********************************************************************************************************
+static int check_exact(const sht4x_handle_t* i_p_handle);
+
+// **********************************************************************************************************
+// Function name    : check_calibration                                                                     *
+// Description      : Check the calibrated conversions against the floating point reference, within 1 LSB.  *
+// Argument         : (sht4x_handle_t*) i_p_handle: Handle of the converted sensor                          *
+//                  : (uint16_t) i_gain: Gain in Q15                                                        *
+//                  : (int16_t) i_offset: Offset in 0.01 unit                                               *
+//                  : (double*) io_p_max_error: Largest error so far, in LSB of the result                  *
+// Return value     : (int) : 0 if every code is within 1 LSB, 1 otherwise                                  *
+// **********************************************************************************************************
+static int check_calibration(sht4x_handle_t* i_p_handle, uint16_t i_gain, int16_t i_offset,
+                             double* io_p_max_error);
+
+// **********************************************************************************************************
+// Function name    : check_send / check_receive / check_delay                                              *
+// Description      : Bus stubs, only needed to create a handle.                                            *
+// **********************************************************************************************************
+static status_e check_send(uint8_t i_address, uint8_t* i_p_data, size_t i_size);
+static status_e check_receive(uint8_t i_address, uint8_t* o_p_data, size_t i_size);
+static void check_delay(uint32_t i_delay_ms);
+
+// **********************************************************************************************************
+//                                            Public fuctions                                               *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : main                                                                                  *
+// Description      : Check every raw code and print the result.                                            *
+// **********************************************************************************************************
+int main(void)
+{
+    // Variable(s) declaration
+    sht4x_handle_t* p_datasheet;
+    sht4x_handle_t* p_calibrated;
+    sht4x_calibration_t calibration;
+    double max_error;
+    size_t gain;
+    size_t offset;
+
+    // A handle with the datasheet constants and one folding a calibration of 1 and 0, both must be exact
+    p_datasheet = sht4x_init(SHT4x_A, &check_send, &check_receive, &check_delay);
+    p_calibrated = sht4x_init(SHT4x_B, &check_send, &check_receive, &check_delay);
+    calibration.temperature_gain = 32768u;
+    calibration.temperature_offset = 0;
+    calibration.humidity_gain = 32768u;
+    calibration.humidity_offset = 0;
+    sht4x_set_calibration(p_calibrated, &calibration);
+    if ((check_exact(p_datasheet) != 0) || (check_exact(p_calibrated) != 0))
+    {
+        return 1;
+    }
+    printf("65536 codes checked: high resolution exact and rounded, standard cropped to 0-100 %%RH\n");
+
+    // Calibrated conversions
+    max_error = 0.0;
+    for (gain = 0u ; gain < (sizeof(g_check_gains) / sizeof(g_check_gains[0])) ; gain++)
+    {
+        for (offset = 0u ; offset < (sizeof(g_check_offsets) / sizeof(g_check_offsets[0])) ; offset++)
+        {
+            if (check_calibration(p_calibrated, g_check_gains[gain], g_check_offsets[offset], &max_error) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    printf("%u calibrations checked: largest error %.3f LSB\n",
+           (unsigned) ((sizeof(g_check_gains) / sizeof(g_check_gains[0])) *
+                       (sizeof(g_check_offsets) / sizeof(g_check_offsets[0]))), max_error);
+    return 0;
+}
+
+// **********************************************************************************************************
+//                                              Private fuctions                                            *
+// **********************************************************************************************************
+// **********************************************************************************************************
+// Function name    : check_round                                                                           *
+// Description      : Reference of offset + multiplier . code / 65535 rounded to the nearest.               *
+// **********************************************************************************************************
+static int64_t check_round(int64_t i_multiplier, int64_t i_offset, uint32_t i_code)
+{
+    // Round half up with a doubled numerator, the offset is an integer so it does not change the rounding
+    return i_offset + (((2 * i_multiplier * i_code) + 65535) / (2 * 65535));
+}
+
+// **********************************************************************************************************
+// Function name    : check_crop                                                                            *
+// Description      : Crop a value to [0, max].                                                             *
+// **********************************************************************************************************
+static int64_t check_crop(int64_t i_value, int64_t i_max)
+{
+    return (i_value < 0) ? 0 : ((i_value > i_max) ? i_max : i_value);
+}
+
+// **********************************************************************************************************
+// Function name    : check_exact                                                                           *
+// Description      : Check the conversions without calibration against the exact datasheet formulas.       *
+// **********************************************************************************************************
+static int check_exact(const sht4x_handle_t* i_p_handle)
+{
+    // Variable(s) declaration
+    uint32_t code;
+    int16_t temperature;
+    uint16_t humidity;
+    int64_t expected_temperature;
+    int64_t expected_humidity;
+
+    for (code = 0u ; code <= 0xFFFFu ; code++)
+    {
+        // High resolution: -45 + 175 . S / 65535 degree Celsius and -6 + 125 . S / 65535 %RH, in 0.01 unit
+        sht4x_convert_high_resolution(i_p_handle, (uint16_t) code, (uint16_t) code, &temperature, &humidity);
+        expected_temperature = check_round(17500, -4500, code);
+        expected_humidity = check_crop(check_round(12500, -600, code), 10000);
+        if ((temperature != expected_temperature) || (humidity != expected_humidity))
+        {
+            printf("high resolution mismatch at 0x%04X: %d %u, expected %lld %lld\n", (unsigned) code,
+                   temperature, humidity, (long long) expected_temperature, (long long) expected_humidity);
+            return 1;
+        }
+
+        // Standard: 0.1 unit with the scale approximated by 2^16 and rounded down, as before
+        sht4x_convert(i_p_handle, (uint16_t) code, (uint16_t) code, &temperature, &humidity);
+        expected_temperature = (((int64_t) code * 1750) >> 16) - 450;
+        expected_humidity = check_crop((((int64_t) code * 1250) >> 16) - 60, 1000);
+        if ((temperature != expected_temperature) || (humidity != expected_humidity))
+        {
+            printf("standard mismatch at 0x%04X: %d %u, expected %lld %lld\n", (unsigned) code,
+                   temperature, humidity, (long long) expected_temperature, (long long) expected_humidity);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// **********************************************************************************************************
+// Function name    : check_calibration                                                                     *
+// Description      : Check the calibrated conversions against the floating point reference, within 1 LSB.  *
+// **********************************************************************************************************
+static int check_calibration(sht4x_handle_t* i_p_handle, uint16_t i_gain, int16_t i_offset,
+                             double* io_p_max_error)
+{
+    // Variable(s) declaration
+    sht4x_calibration_t calibration;
+    uint32_t code;
+    int16_t temperature;
+    uint16_t humidity;
+    double gain;
+    double reference[4];
+    double error[4];
+    int index;
+
+    // Same calibration on both values
+    calibration.temperature_gain = i_gain;
+    calibration.temperature_offset = i_offset;
+    calibration.humidity_gain = i_gain;
+    calibration.humidity_offset = i_offset;
+    sht4x_set_calibration(i_p_handle, &calibration);
+    gain = (double) i_gain / 32768.0;
+
+    for (code = 0u ; code <= 0xFFFFu ; code++)
+    {
+        // Reference: gain . datasheet value + offset, rounded to the nearest in high resolution and down in
+        // standard resolution (2^16 scale), humidity cropped
+        reference[0] = floor(0.5 + (gain * ((17500.0 * code / 65535.0) - 4500.0)) + i_offset);
+        reference[1] = fmin(fmax(floor(0.5 + (gain * ((12500.0 * code / 65535.0) - 600.0)) + i_offset), 0.0),
+                            10000.0);
+        reference[2] = floor((gain * ((1750.0 * code / 65536.0) - 450.0)) + (i_offset / 10.0));
+        reference[3] = fmin(fmax(floor((gain * ((1250.0 * code / 65536.0) - 60.0)) + (i_offset / 10.0)), 0.0),
+                            1000.0);
+
+        sht4x_convert_high_resolution(i_p_handle, (uint16_t) code, (uint16_t) code, &temperature, &humidity);
+        error[0] = fabs(temperature - reference[0]);
+        error[1] = fabs(humidity - reference[1]);
+        sht4x_convert(i_p_handle, (uint16_t) code, (uint16_t) code, &temperature, &humidity);
+        error[2] = fabs(temperature - reference[2]);
+        error[3] = fabs(humidity - reference[3]);
+
+        for (index = 0 ; index < 4 ; index++)
+        {
+            if (error[index] > 1.0)
+            {
+                printf("calibration mismatch (gain %u, offset %d) at 0x%04X: value %d off by %.0f\n",
+                       i_gain, i_offset, (unsigned) code, index, error[index]);
+                return 1;
+            }
+            *io_p_max_error = fmax(*io_p_max_error, error[index]);
+        }
+    }
+
+    return 0;
+}
+
+// **********************************************************************************************************
+// Function name    : check_send / check_receive / check_delay                                              *
+// Description      : Bus stubs, only needed to create a handle.                                            *
+// **********************************************************************************************************
+static status_e check_send(uint8_t i_address, uint8_t* i_p_data, size_t i_size)
+{
+    (void) i_address;
+    (void) i_p_data;
+    (void) i_size;
+    return STATUS_ERROR;
+}
+
+static status_e check_receive(uint8_t i_address, uint8_t* o_p_data, size_t i_size)
+{
+    (void) i_address;
+    (void) o_p_data;
+    (void) i_size;
+    return STATUS_ERROR;
+}
+
+static void check_delay(uint32_t i_delay_ms)
+{
+    (void) i_delay_ms;
+}
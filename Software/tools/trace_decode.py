@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# **********************************************************************************************************
+# File name         : trace_decode.py                                                                      *
+# Author            : Richard I.                                                                           *
+# Date              : 18/10/2026                                                                           *
+# Description       : Render the trace frames sent by the sensor as a timeline                             *
+#                   : Usage: trace_decode.py <capture.bin | ->                                             *
+# **********************************************************************************************************
+import struct
+import sys
+
+from com_frames import FRAME_TRACE, iter_frames, read_input
+
+# Traced events (keep in sync with app/Include/trace.h)
+EVENTS = [
+    'TIM_IRQ',
+    'SYSTICK',
+    'TASK_START',
+    'TASK_END',
+    'I2C_SEND',
+    'I2C_RECEIVE',
+    'SHT4X_ERROR',
+    'UART_TX',
+    'COMMAND',
+    'I2C_RECOVER',
+    'HEATER',
+]
+
+# Argument names of the SHT4X_ERROR event
+SHT4X_ERRORS = ['HANDLE', 'SEND', 'RECEIVE', 'CRC']
+
+# Record layout: tick in ms, 1 MHz timestamp, event, argument
+RECORD = struct.Struct('<IHBB')
+
+
+def render(payload):
+    """Print the records of a trace frame, with the time elapsed since the first one."""
+    origin_us = None
+    previous = None
+    for tick_ms, time_us, event, arg in RECORD.iter_unpack(payload):
+        # The 16 bits timestamp gives the fine delta, the ms tick resolves its wraps
+        if previous is None:
+            absolute_us = tick_ms * 1000
+            origin_us = absolute_us
+        else:
+            delta_ms = tick_ms - previous[0]
+            if delta_ms < 60:
+                delta_us = (time_us - previous[1]) & 0xFFFF
+            else:
+                delta_us = delta_ms * 1000
+            absolute_us = previous[2] + delta_us
+        previous = (tick_ms, time_us, absolute_us)
+
+        name = EVENTS[event] if event < len(EVENTS) else 'EVENT_%d' % event
+        if name == 'SHT4X_ERROR' and arg < len(SHT4X_ERRORS):
+            detail = SHT4X_ERRORS[arg]
+        else:
+            detail = str(arg)
+        print('%12.3f ms  tick %10u  %-12s %s' % ((absolute_us - origin_us) / 1000.0, tick_ms, name, detail))
+
+
+def main():
+    if len(sys.argv) != 2:
+        print('Usage: %s <capture.bin | ->' % sys.argv[0])
+        return 1
+    for frame_type, payload in iter_frames(read_input(sys.argv[1])):
+        if frame_type == FRAME_TRACE:
+            print('--- trace (%d records)' % (len(payload) // RECORD.size))
+            render(payload)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())